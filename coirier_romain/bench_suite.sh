@@ -0,0 +1,109 @@
+#!/bin/bash
+
+# Suite de mesures des serveurs des questions 1 (threads) et 2 (processus lourds)
+# Compile serveurs et clients de mesure (bench_workload.c) dans un répertoire
+# temporaire, lance chaque serveur sans terminal (journal dans ce répertoire),
+# le soumet à chaque charge puis l'arrête (Ctrl + c) avant la suivante :
+# chaque charge part d'un serveur neuf.
+# Résultat : un document JSON (débit, percentiles de latence par charge).
+#
+# Utilisation : ./bench_suite.sh [fichier_resultat]
+# Paramètres (variables d'environnement) :
+#   NB_CLIENTS (8), NB_REQUESTS (2000, par client), CATALOG_SIZE (1000000,
+#   charge large-catalog, question 2 seulement), SEED (103),
+#   WORKLOADS ("read-heavy write-heavy hot-show large-catalog")
+# Les réservations sont d'une place : une fois les spectacles complets,
+# les réservations suivantes mesurent le chemin du refus ("refused").
+
+ROOT_DIR=$(cd "$(dirname "$0")" && pwd)
+OUT=${1:-bench_results.json}
+NB_CLIENTS=${NB_CLIENTS:-8}
+NB_REQUESTS=${NB_REQUESTS:-2000}
+CATALOG_SIZE=${CATALOG_SIZE:-1000000}
+SEED=${SEED:-103}
+WORKLOADS=${WORKLOADS:-"read-heavy write-heavy hot-show large-catalog"}
+RUN_TIMEOUT=300 # durée max d'une charge (s)
+
+# Sources des serveurs (cf compile_and_run.sh)
+Q1_SERVER_SRC="server.c show_table.c holds.c bookings.c waitlist.c dedup.c rate_limit.c admission.c stats.c scheduler.c coroutine.c slab.c request_pool.c perf_counters.c lock_profile.c pending_replies.c ticket_table.c timer_wheel.c"
+Q2_SERVER_SRC="server.c numa_placement.c replication.c admission.c shm_slab.c shm_heap.c show_index.c show_lookup.c huge_pages.c lock_profile.c handover.c pending_replies.c"
+
+RUN_DIR=$(mktemp -d)
+SERVER_PID=""
+
+# Arrêt du serveur en cours (groupe de process : fils de consultation / réservation compris)
+stop_server() {
+    if [ -n "$SERVER_PID" ]; then
+        kill -INT -- -$SERVER_PID 2>/dev/null
+        wait $SERVER_PID 2>/dev/null
+        SERVER_PID=""
+    fi
+}
+
+cleanup() {
+    stop_server
+    rm -rf "$RUN_DIR"
+}
+trap cleanup EXIT
+
+# Compilation : $1 question, $2 sources du serveur, $3 options supplémentaires
+build() {
+    echo "Compilation de la question $1..." >&2
+    mkdir -p "$RUN_DIR/question$1"
+    touch "$RUN_DIR/question$1/NSY" # fichier de la clé ftok
+    (cd "$ROOT_DIR/question$1" \
+        && gcc -O2 $3 -o "$RUN_DIR/question$1/server" $2 \
+        && gcc -O2 -o "$RUN_DIR/question$1/bench_workload" bench_workload.c)
+    if [ $? -ne 0 ]; then
+        echo "Echec de la compilation de la question $1." >&2
+        exit 1
+    fi
+}
+
+# Une charge : $1 question, $2 charge, $3 options du serveur, $4... arguments du client
+run_workload() {
+    local question=$1 workload=$2 server_options=$3
+    shift 3
+    echo "Question $question, charge $workload..." >&2
+    cd "$RUN_DIR/question$question"
+    setsid ./server $server_options >> server.log 2>&1 &
+    SERVER_PID=$!
+    local result
+    result=$(timeout $RUN_TIMEOUT ./bench_workload $workload $NB_CLIENTS $NB_REQUESTS "$@")
+    stop_server
+    cd - > /dev/null
+    if [ -z "$result" ]; then
+        echo "Echec de la charge $workload (cf $RUN_DIR/question$question/server.log)." >&2
+        return
+    fi
+    [ -n "$RESULTS" ] && RESULTS+=$',\n'
+    RESULTS+="    $result"
+}
+
+build 1 "$Q1_SERVER_SRC" -pthread
+build 2 "$Q2_SERVER_SRC"
+
+RESULTS=""
+for WORKLOAD in $WORKLOADS; do
+    if [ "$WORKLOAD" = "large-catalog" ]; then
+        # catalogue fixe de 3 spectacles en question 1
+        run_workload 2 $WORKLOAD "-c $CATALOG_SIZE" $CATALOG_SIZE $SEED
+    else
+        # question 1 sans limitation du débit par client
+        run_workload 1 $WORKLOAD "-r 0" $SEED
+        run_workload 2 $WORKLOAD "" 0 $SEED
+    fi
+done
+
+COMMIT=$(git -C "$ROOT_DIR" rev-parse --short HEAD 2>/dev/null)
+{
+    echo "{"
+    echo "  \"date\": \"$(date -u +%Y-%m-%dT%H:%M:%SZ)\","
+    echo "  \"commit\": \"${COMMIT:-inconnu}\","
+    echo "  \"cpus\": $(nproc),"
+    echo "  \"results\": ["
+    echo "$RESULTS"
+    echo "  ]"
+    echo "}"
+} > "$OUT"
+echo "Resultats dans $OUT." >&2
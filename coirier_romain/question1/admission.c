@@ -0,0 +1,120 @@
+/*******************************************************************************
+ * @file admission.c
+ * @brief Implémentation du contrôle d'admission de la question 1.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * cf admission.h
+ * Seule la boucle de réception admet des requêtes (incrément du nb en cours),
+ * les threads de traitement ne font que le décrémenter : le test de la limite
+ * et l'incrément n'ont donc pas besoin d'être indivisibles.
+ ******************************************************************************/
+
+#include "admission.h"
+#include "server.h"
+
+// variables du module
+static int max_in_flight = DEFAULT_MAX_IN_FLIGHT;
+static int nb_in_flight; // requêtes admises et pas encore répondues
+static int peak_in_flight;
+static unsigned long nb_received;
+static unsigned long nb_rejected;
+static unsigned long queue_depth; // dernière profondeur mesurée de la file
+static unsigned long max_queue_depth;
+
+/**
+ * @brief Fixe la limite du nb de requêtes en cours
+ *
+ * @param max nb max de requêtes en cours de traitement (> 0)
+ */
+void initAdmission(int max)
+{
+    max_in_flight = max;
+    printf("Controle d'admission : %d requetes en cours au maximum.\n", max_in_flight);
+}
+
+/**
+ * @brief Mesure le nb de messages en attente dans la file
+ */
+static void sampleQueueDepth()
+{
+    struct msqid_ds queue_info;
+
+    if (msgctl(msg_queue_id, IPC_STAT, &queue_info) == -1)
+    {
+        return;
+    }
+    __atomic_store_n(&queue_depth, queue_info.msg_qnum, __ATOMIC_RELAXED);
+    if (queue_info.msg_qnum > max_queue_depth)
+    {
+        __atomic_store_n(&max_queue_depth, queue_info.msg_qnum, __ATOMIC_RELAXED);
+    }
+}
+
+/**
+ * @brief Admet ou refuse une requête reçue (boucle de réception uniquement)
+ *
+ * Une requête admise doit être terminée par releaseRequest()
+ *
+ * @return bool : true si la requête est admise, false si le serveur est saturé
+ */
+bool admitRequest()
+{
+    unsigned long received = __atomic_add_fetch(&nb_received, 1, __ATOMIC_RELAXED);
+
+    if (received % QUEUE_SAMPLE_PERIOD == 0)
+    {
+        sampleQueueDepth();
+    }
+    int in_flight = __atomic_load_n(&nb_in_flight, __ATOMIC_ACQUIRE);
+    if (in_flight >= max_in_flight)
+    {
+        __atomic_add_fetch(&nb_rejected, 1, __ATOMIC_RELAXED);
+        sampleQueueDepth(); // pour le délai de réémission
+        return false;
+    }
+    in_flight = __atomic_add_fetch(&nb_in_flight, 1, __ATOMIC_ACQ_REL);
+    if (in_flight > peak_in_flight)
+    {
+        __atomic_store_n(&peak_in_flight, in_flight, __ATOMIC_RELAXED);
+    }
+    return true;
+}
+
+/**
+ * @brief Fin de traitement d'une requête admise (threads de traitement)
+ */
+void releaseRequest()
+{
+    __atomic_sub_fetch(&nb_in_flight, 1, __ATOMIC_ACQ_REL);
+}
+
+/**
+ * @brief Délai de réémission conseillé à un client refusé
+ *
+ * BUSY_RETRY_MS, augmenté d'autant pour chaque "limite" de messages en attente
+ *
+ * @return int : le délai en ms
+ */
+int getRetryAfterMs()
+{
+    unsigned long depth = __atomic_load_n(&queue_depth, __ATOMIC_RELAXED);
+    return BUSY_RETRY_MS * (1 + (int)(depth / max_in_flight));
+}
+
+/**
+ * @brief Affiche les compteurs du contrôle d'admission
+ */
+void printAdmissionStats()
+{
+    printf("Admission : %lu requetes recues, %lu refusees (serveur sature).\n",
+        __atomic_load_n(&nb_received, __ATOMIC_RELAXED),
+        __atomic_load_n(&nb_rejected, __ATOMIC_RELAXED));
+    printf("Admission : %d requetes en cours (pic %d, limite %d).\n",
+        __atomic_load_n(&nb_in_flight, __ATOMIC_RELAXED),
+        __atomic_load_n(&peak_in_flight, __ATOMIC_RELAXED), max_in_flight);
+    printf("File de messages : %lu messages en attente (max mesure %lu).\n",
+        __atomic_load_n(&queue_depth, __ATOMIC_RELAXED),
+        __atomic_load_n(&max_queue_depth, __ATOMIC_RELAXED));
+}
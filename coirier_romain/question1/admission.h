@@ -0,0 +1,35 @@
+/*******************************************************************************
+ * @file admission.h
+ * @brief Contrôle d'admission des requêtes du serveur de la question 1.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * Le nb de requêtes en cours de traitement (threads créés et pas encore répondus)
+ * est borné (option -m du serveur, DEFAULT_MAX_IN_FLIGHT par défaut).
+ * Au delà, la requête est refusée immédiatement par une réponse STATUS_BUSY
+ * indiquant au client un délai avant réémission (retry_after_ms), d'autant plus
+ * long que la file de messages est chargée : la surcharge se traduit par des refus
+ * rapides plutôt que par un nb de threads et une latence sans limite.
+ *
+ * La profondeur de la file (msg_qnum) est mesurée toutes les QUEUE_SAMPLE_PERIOD
+ * requêtes et à chaque refus. Les compteurs sont affichés sur SIGUSR1 (cf stats.h).
+ ******************************************************************************/
+
+#ifndef ADMISSION_H
+#define ADMISSION_H
+
+#include "common.h"
+
+#define DEFAULT_MAX_IN_FLIGHT 256 // nb max de requêtes en cours de traitement
+#define BUSY_RETRY_MS 50 // délai de réémission conseillé, file vide
+#define QUEUE_SAMPLE_PERIOD 16 // mesure de la profondeur de la file toutes les N requêtes
+
+//prototypes de fonctions
+void initAdmission(int max_in_flight);
+bool admitRequest();
+void releaseRequest();
+int getRetryAfterMs();
+void printAdmissionStats();
+
+#endif
@@ -0,0 +1,103 @@
+/*******************************************************************************
+ * @file bench_layout.c
+ * @brief Mesure de contention sur des spectacles voisins très demandés (question 1).
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * Chaque thread modifie sans relâche le compteur de places de "son" spectacle,
+ * les spectacles étant voisins dans le tableau (index 0, 1, 2...) :
+ * avec la disposition par défaut ils partagent une ligne de cache (faux partage),
+ * avec -DSEAT_TABLE_SOA chaque compteur a la sienne (cf show_table.h).
+ * Avec l'argument verrou, chaque modification est faite sous un verrou unique,
+ * comme dans le serveur où toute écriture de places passe par la section critique
+ * d'écriture (sémaphore RESOURCE_SEM commun à tout le tableau).
+ *
+ * Compilation des deux variantes :
+ * $ gcc -O2 -pthread -o bench_aos bench_layout.c show_table.c
+ * $ gcc -O2 -pthread -DSEAT_TABLE_SOA -o bench_soa bench_layout.c show_table.c
+ * Utilisation : ./bench_aos [nb_threads] [nb_operations_par_thread] [verrou]
+ *
+ * @note la mesure n'a de sens qu'avec au moins 2 coeurs.
+ * @note le faux partage mesuré sans verrou suppose des écritures simultanées
+ * sur des spectacles voisins : dans le serveur actuel, le verrou unique les
+ * sérialise et la disposition -DSEAT_TABLE_SOA n'apporte de gain qu'avec des
+ * verrous par groupe de spectacles (mode verrou : écart attendu nul).
+ ******************************************************************************/
+
+#include "show_table.h"
+
+#include <pthread.h>
+#include <time.h>
+
+#define DEFAULT_NB_OPERATIONS 20000000L
+#define MAX_BENCH_THREADS 64
+
+static long nb_operations;
+static bool locked = false; // modifications sous verrou unique (chemin du serveur)
+static pthread_mutex_t resource_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * @brief Corps d'un thread : modifications répétées du compteur d'un spectacle
+ *
+ * @param void* l'index du spectacle
+ */
+static void *hammerShow(void *arg)
+{
+    int show_index = (int)(long)arg;
+
+    for (long i = 0; i < nb_operations; i++)
+    {
+        if (locked)
+        {
+            // section critique d'écriture commune à tout le tableau
+            pthread_mutex_lock(&resource_mutex);
+            SHOW_SEATS(show_index)++;
+            pthread_mutex_unlock(&resource_mutex);
+            continue;
+        }
+        // accès atomique, comme une écriture publiée aux autres coeurs
+        __atomic_fetch_add(&SHOW_SEATS(show_index), 1, __ATOMIC_RELAXED);
+    }
+    return NULL;
+}
+
+int main(int argc, char *argv[])
+{
+    int nb_threads = (argc > 1) ? atoi(argv[1]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    pthread_t threads[MAX_BENCH_THREADS];
+    struct timespec start, end;
+
+    nb_operations = (argc > 2) ? atol(argv[2]) : DEFAULT_NB_OPERATIONS;
+    locked = (argc > 3) && strcmp(argv[3], "verrou") == 0;
+    if (nb_threads < 1 || nb_threads > MAX_BENCH_THREADS)
+    {
+        fprintf(stderr, "Nb de threads non valide (1 a %d).\n", MAX_BENCH_THREADS);
+        exit(EXIT_FAILURE);
+    }
+    allocShowTable(nb_threads);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < nb_threads; i++)
+    {
+        if (pthread_create(&threads[i], NULL, hammerShow, (void *)(long)i) != 0)
+        {
+            perror("Echec creation du thread.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    for (int i = 0; i < nb_threads; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    double elapsed_ns = (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+    printf("Disposition : %s%s\n", getShowTableLayout(), locked ? ", verrou unique" : "");
+    printf("%d threads, %ld operations par thread : %.2f ns par operation, %.1f Mop/s au total\n",
+        nb_threads, nb_operations, elapsed_ns / nb_operations,
+        nb_threads * nb_operations / elapsed_ns * 1e3);
+
+    freeShowTable();
+    return 0;
+}
@@ -0,0 +1,85 @@
+/*******************************************************************************
+ * @file bench_scheduler.c
+ * @brief Comparaison ordonnanceur central / vol de travail (question 1).
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * Un producteur range des requêtes fictives (consultations et réservations
+ * de nb_clients pid différents) dans l'ordonnanceur, que nb_threads threads
+ * de traitement vident ; chaque traitement est une courte boucle de calcul.
+ * Le débit mesuré reflète le coût de l'ordonnancement (verrous, réveils).
+ *
+ * Compilation :
+ * $ gcc -O2 -pthread -o bench_scheduler bench_scheduler.c scheduler.c coroutine.c slab.c
+ * Utilisation : ./bench_scheduler central|vol [nb_threads] [nb_requetes] [nb_clients]
+ *
+ * @note la mesure n'a de sens qu'avec plusieurs coeurs.
+ ******************************************************************************/
+
+#include "scheduler.h"
+
+#include <sched.h>
+#include <time.h>
+
+#define DEFAULT_NB_TASKS 2000000L
+#define DEFAULT_NB_CLIENTS 64
+#define TASK_WORK 200 // itérations de calcul par requête
+
+static long nb_done;
+
+/**
+ * @brief Traitement d'une requête fictive
+ */
+static void benchHandler(Task *task)
+{
+    volatile unsigned int value = task->msg_req.pid;
+
+    for (int i = 0; i < TASK_WORK; i++)
+    {
+        value = value * 1664525U + 1013904223U;
+    }
+    free(task);
+    __atomic_add_fetch(&nb_done, 1, __ATOMIC_RELEASE);
+}
+
+int main(int argc, char *argv[])
+{
+    bool work_stealing = (argc > 1) && strcmp(argv[1], "vol") == 0;
+    int nb_threads = (argc > 2) ? atoi(argv[2]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    long nb_tasks = (argc > 3) ? atol(argv[3]) : DEFAULT_NB_TASKS;
+    int nb_clients = (argc > 4) ? atoi(argv[4]) : DEFAULT_NB_CLIENTS;
+    struct timespec start, end;
+
+    if (argc < 2 || nb_threads < 1 || nb_tasks < 1 || nb_clients < 1)
+    {
+        fprintf(stderr, "Utilisation : %s central|vol [nb_threads] [nb_requetes] [nb_clients]\n", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+    initScheduler(nb_threads, work_stealing, false, benchHandler);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (long i = 0; i < nb_tasks; i++)
+    {
+        Task *task = (Task *)malloc(sizeof(Task));
+        if (task == NULL)
+        {
+            perror("Echec malloc.\n");
+            exit(EXIT_FAILURE);
+        }
+        task->msg_req.pid = 1 + i % nb_clients;
+        task->msg_req.request_type = (i % 4 == 0) ? REQUEST_RESA : REQUEST_CONSULT;
+        submitTask(task);
+    }
+    while (__atomic_load_n(&nb_done, __ATOMIC_ACQUIRE) < nb_tasks)
+    {
+        sched_yield();
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    double elapsed_ns = (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+    printf("%ld requetes, %d clients : %.1f ns par requete, %.2f Mreq/s\n",
+        nb_tasks, nb_clients, elapsed_ns / nb_tasks, nb_tasks / elapsed_ns * 1e3);
+    printSchedulerStats();
+    return 0;
+}
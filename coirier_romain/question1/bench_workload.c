@@ -0,0 +1,325 @@
+/*******************************************************************************
+ * @file bench_workload.c
+ * @brief Client de mesure du serveur de la question 1 (cf bench_suite.sh).
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * nb_clients process clients envoient chacun nb_requetes requêtes au serveur
+ * en cours d'exécution, une à la fois (boucle fermée), selon une charge :
+ * -> read-heavy : 95% de consultations, spectacles tirés uniformément
+ * -> write-heavy : 80% de réservations (1 place), spectacles tirés uniformément
+ * -> hot-show : moitié consultations, moitié réservations, 90% sur le même spectacle
+ * (le catalogue de la question 1 se limite à SHOW_IDS : pas de charge large-catalog)
+ * Les tirages sont faits par un générateur initialisé par la graine et le
+ * numéro du client : une même commande rejoue la même suite de requêtes.
+ *
+ * Les clients ne partent qu'après une première consultation traitée par le
+ * serveur : sa mise en route (catalogue, index) n'entre pas dans la mesure.
+ *
+ * Le résultat est une ligne JSON sur la sortie standard : débit de toutes les
+ * réponses (throughput_rps) et des seules requêtes traitées (accepted_rps, hors
+ * refus du serveur saturé), percentiles de latence (en µs) des requêtes traitées
+ * et décompte des réponses (acceptées, refusées faute de places, serveur saturé, erreurs).
+ *
+ * Compilation :
+ * $ gcc -O2 -o bench_workload bench_workload.c
+ * Utilisation : ./bench_workload charge [nb_clients] [nb_requetes] [graine]
+ * (serveur lancé avec -r 0 : sinon le débit de chaque client est limité, cf rate_limit.h)
+ ******************************************************************************/
+
+#include "common.h"
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <time.h>
+
+#define DEFAULT_NB_CLIENTS 8
+#define DEFAULT_NB_REQUESTS 2000 // par client
+#define DEFAULT_SEED 103
+#define SERVER_WAIT_MS 30000 // attente max de la file du serveur
+#define HOT_SHOW_PERCENT 90
+
+// Charges de travail
+typedef struct {
+    const char *name;
+    int write_percent; // part des réservations
+    int hot_percent; // part des requêtes sur le premier spectacle
+} Workload;
+
+static const Workload WORKLOADS[] = {
+    {"read-heavy", 5, 0},
+    {"write-heavy", 80, 0},
+    {"hot-show", 50, HOT_SHOW_PERCENT},
+    {NULL, 0, 0} // terminaison du tableau
+};
+
+// Décompte des réponses d'un client (dans une projection partagée avec le père)
+typedef struct {
+    long nb_ok; // consultations, réservations acceptées
+    long nb_refused; // réservations refusées (places insuffisantes, spectacle inconnu)
+    long nb_busy; // serveur saturé
+    long nb_errors; // envoi / réception en échec
+} ClientCounters;
+
+/**
+ * @brief Tirage pseudo-aléatoire reproductible (xorshift64)
+ */
+static unsigned long nextRandom(unsigned long *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+/**
+ * @brief Instant courant en ns
+ */
+static long nowNs()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000000000L + now.tv_nsec;
+}
+
+/**
+ * @brief Comparaison de latences pour qsort()
+ */
+static int compareLatencies(const void *a, const void *b)
+{
+    long x = *(const long *)a;
+    long y = *(const long *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Percentile p (0 à 1) de latences triées, en µs
+ */
+static double getPercentileUs(const long *latencies, long nb_latencies, double p)
+{
+    return (nb_latencies > 0) ? latencies[(long)((nb_latencies - 1) * p)] / 1e3 : 0.0;
+}
+
+/**
+ * @brief Attend que le serveur traite une consultation
+ *
+ * La file de messages peut exister avant que le serveur ne serve
+ * (construction du catalogue) : une consultation est envoyée puis réémise
+ * tant que le serveur est saturé.
+ *
+ * @return int : l'identifiant de la file, -1 au bout de SERVER_WAIT_MS
+ */
+static int waitForServer(key_t key)
+{
+    Request msg_req;
+    Response msg_resp;
+    int queue_id;
+    int waited_ms;
+
+    for (waited_ms = 0; (queue_id = msgget(key, 0666)) == -1; waited_ms += 10)
+    {
+        if (waited_ms >= SERVER_WAIT_MS)
+        {
+            return -1;
+        }
+        usleep(10000);
+    }
+
+    memset(&msg_req, 0, sizeof(msg_req));
+    msg_req.msg_type = MESSAGE_TYPE;
+    msg_req.pid = getpid();
+    msg_req.request_type = REQUEST_CONSULT;
+    msg_req.request_id = 1;
+    strncpy(msg_req.msg.show_id, SHOW_IDS[0], SHOW_ID_LEN);
+    if (msgsnd(queue_id, &msg_req, sizeof(Request) - sizeof(long), 0) == -1)
+    {
+        return -1;
+    }
+    while (waited_ms < SERVER_WAIT_MS)
+    {
+        if (msgrcv(queue_id, &msg_resp, sizeof(Response) - sizeof(long), msg_req.pid, IPC_NOWAIT) == -1)
+        {
+            if (errno != ENOMSG)
+            {
+                return -1;
+            }
+            usleep(10000);
+            waited_ms += 10;
+            continue;
+        }
+        if (msg_resp.status != STATUS_BUSY)
+        {
+            return queue_id;
+        }
+            msg_req.request_id++; // nouvelle requête : pas de rejeu du refus
+        if (msgsnd(queue_id, &msg_req, sizeof(Request) - sizeof(long), 0) == -1)
+        {
+            return -1;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Boucle d'un process client : nb_requests requêtes, latences relevées
+ * (requêtes traitées seulement, rangées à la suite)
+ */
+static void runClient(int queue_id, const Workload *workload, int nb_shows,
+    unsigned long seed, long nb_requests, long *latencies, ClientCounters *counters)
+{
+    unsigned long random_state = seed * 2654435761UL + 1;
+    Request msg_req;
+    Response msg_resp;
+
+    memset(&msg_req, 0, sizeof(msg_req));
+    msg_req.msg_type = MESSAGE_TYPE;
+    msg_req.pid = getpid();
+    for (long n = 0; n < nb_requests; n++)
+    {
+        bool write = (long)(nextRandom(&random_state) % 100) < workload->write_percent;
+        int j = ((long)(nextRandom(&random_state) % 100) < workload->hot_percent)
+            ? 0 : (int)(nextRandom(&random_state) % nb_shows);
+
+        strncpy(msg_req.msg.show_id, SHOW_IDS[j], SHOW_ID_LEN);
+        msg_req.request_type = write ? REQUEST_RESA : REQUEST_CONSULT;
+        msg_req.msg.nb_seats = write ? 1 : 0;
+        msg_req.request_id = n + 1; // pas de réémission : chaque requête est nouvelle
+
+        long start = nowNs();
+        if (msgsnd(queue_id, &msg_req, sizeof(Request) - sizeof(long), 0) == -1
+            || msgrcv(queue_id, &msg_resp, sizeof(Response) - sizeof(long), msg_req.pid, 0) == -1)
+        {
+            // serveur arrêté (file supprimée) : inutile d'insister
+            counters->nb_errors += nb_requests - n;
+            return;
+        }
+        long latency = nowNs() - start;
+
+        if (msg_resp.status != STATUS_BUSY)
+        {
+            latencies[counters->nb_ok + counters->nb_refused] = latency;
+        }
+        if (msg_resp.status == STATUS_BUSY)
+        {
+            counters->nb_busy++;
+        }
+        else if (write && msg_resp.msg.nb_seats <= 0)
+        {
+            counters->nb_refused++;
+        }
+        else
+        {
+            counters->nb_ok++;
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const Workload *workload = WORKLOADS;
+    int nb_clients = (argc > 2) ? atoi(argv[2]) : DEFAULT_NB_CLIENTS;
+    long nb_requests = (argc > 3) ? atol(argv[3]) : DEFAULT_NB_REQUESTS;
+    unsigned long seed = (argc > 4) ? strtoul(argv[4], NULL, 10) : DEFAULT_SEED;
+    int nb_shows;
+
+    while (argc > 1 && workload->name != NULL && strcmp(workload->name, argv[1]) != 0)
+    {
+        workload++;
+    }
+    if (argc < 2 || workload->name == NULL || nb_clients < 1 || nb_requests < 1)
+    {
+        fprintf(stderr, "Utilisation : %s read-heavy|write-heavy|hot-show"
+            " [nb_clients] [nb_requetes] [graine]\n", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+    for (nb_shows = 0; SHOW_IDS[nb_shows] != NULL; nb_shows++);
+
+    int queue_id = waitForServer(ftok(KEY_FILENAME, KEY_ID));
+    if (queue_id == -1)
+    {
+        perror("Serveur introuvable (file de messages).\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // latences et compteurs des clients, partagés avec le père
+    long nb_total = nb_clients * nb_requests;
+    size_t size = nb_total * sizeof(long) + nb_clients * sizeof(ClientCounters);
+    long *latencies = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (latencies == MAP_FAILED)
+    {
+        perror("Echec mmap.\n");
+        exit(EXIT_FAILURE);
+    }
+    ClientCounters *counters = (ClientCounters *)(latencies + nb_total);
+
+    // départ simultané des clients : fermeture du tube par le père
+    int start_pipe[2];
+    if (pipe(start_pipe) == -1)
+    {
+        perror("Echec pipe.\n");
+        exit(EXIT_FAILURE);
+    }
+    fflush(stdout);
+    for (int c = 0; c < nb_clients; c++)
+    {
+        pid_t pid = fork();
+        if (pid == -1)
+        {
+            perror("Echec fork.\n");
+            exit(EXIT_FAILURE);
+        }
+        if (pid == 0)
+        {
+            char byte;
+            close(start_pipe[1]);
+            if (read(start_pipe[0], &byte, 1) == -1)
+            {
+                exit(EXIT_FAILURE);
+            }
+            runClient(queue_id, workload, nb_shows, seed + c, nb_requests,
+                latencies + c * nb_requests, &counters[c]);
+            exit(EXIT_SUCCESS);
+        }
+    }
+    close(start_pipe[0]);
+    long start = nowNs();
+    close(start_pipe[1]);
+    while (wait(NULL) > 0);
+    double elapsed_s = (nowNs() - start) / 1e9;
+
+    // agrégation
+    ClientCounters total = {0, 0, 0, 0};
+    long nb_measured = 0;
+    for (int c = 0; c < nb_clients; c++)
+    {
+        long nb_accepted = counters[c].nb_ok + counters[c].nb_refused;
+        // latences relevées rangées à la suite
+        memmove(latencies + nb_measured, latencies + c * nb_requests, nb_accepted * sizeof(long));
+        nb_measured += nb_accepted;
+        total.nb_ok += counters[c].nb_ok;
+        total.nb_refused += counters[c].nb_refused;
+        total.nb_busy += counters[c].nb_busy;
+        total.nb_errors += counters[c].nb_errors;
+    }
+    qsort(latencies, nb_measured, sizeof(long), compareLatencies);
+    double mean_us = 0;
+    for (long n = 0; n < nb_measured; n++)
+    {
+        mean_us += latencies[n] / 1e3;
+    }
+    printf("{\"question\": 1, \"architecture\": \"threads\", \"workload\": \"%s\", "
+        "\"clients\": %d, \"requests\": %ld, \"shows\": %d, \"seed\": %lu, "
+        "\"duration_s\": %.3f, \"throughput_rps\": %.1f, \"accepted_rps\": %.1f, "
+        "\"latency_us\": {\"mean\": %.1f, \"p50\": %.1f, \"p90\": %.1f, \"p99\": %.1f, "
+        "\"p999\": %.1f, \"max\": %.1f}, "
+        "\"ok\": %ld, \"refused\": %ld, \"busy\": %ld, \"errors\": %ld}\n",
+        workload->name, nb_clients, nb_total, nb_shows, seed,
+        elapsed_s, (nb_measured + total.nb_busy) / elapsed_s, nb_measured / elapsed_s,
+        nb_measured > 0 ? mean_us / nb_measured : 0.0, getPercentileUs(latencies, nb_measured, 0.5), getPercentileUs(latencies, nb_measured, 0.9),
+        getPercentileUs(latencies, nb_measured, 0.99), getPercentileUs(latencies, nb_measured, 0.999),
+        getPercentileUs(latencies, nb_measured, 1.0),
+        total.nb_ok, total.nb_refused, total.nb_busy, total.nb_errors);
+    munmap(latencies, size);
+    return total.nb_errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
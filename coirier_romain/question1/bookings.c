@@ -0,0 +1,108 @@
+/*******************************************************************************
+ * @file bookings.c
+ * @brief Implémentation des réservations du serveur de la question 1.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * cf bookings.h
+ *
+ * @note la table est protégée par un mutex (bookings_mutex), pris après
+ * celui des pré-réservations et avant les sections critiques du tableau des spectacles.
+ ******************************************************************************/
+
+#include "bookings.h"
+#include "server.h"
+#include "ticket_table.h"
+
+#include <pthread.h>
+
+typedef struct {
+    TicketSlot slot; // en-tête de la table des tickets
+    int show_index;
+    signed char nb_seats;
+} Booking;
+
+// variables du module
+static TicketTable booking_table;
+static pthread_mutex_t bookings_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * @brief Initialise la table des réservations (vide)
+ */
+void initBookings()
+{
+    initTicketTable(&booking_table, sizeof(Booking), MAX_TICKETS);
+}
+
+/**
+ * @brief Enregistre une réservation dont les places ont déjà été retirées
+ *
+ * @param show_index l'index du spectacle dans shows[]
+ * @param nb_seats le nb de places réservées
+ * @return le numéro de réservation, 0 si la table est pleine
+ */
+unsigned int recordBooking(int show_index, signed char nb_seats)
+{
+    Booking *booking;
+    unsigned int booking_id = 0;
+
+    pthread_mutex_lock(&bookings_mutex);
+    if ((booking = (Booking *)allocTicket(&booking_table)) != NULL)
+    {
+        booking->show_index = show_index;
+        booking->nb_seats = nb_seats;
+        booking_id = booking->slot.id;
+    }
+    pthread_mutex_unlock(&bookings_mutex);
+
+    return booking_id;
+}
+
+/**
+ * @brief Retire une réservation de la table, sans rendre ses places
+ *
+ * @param booking_id le numéro de la réservation
+ * @param Message* reçoit le spectacle et le nb de places à rendre
+ *                 (tous les bits à 0 si la réservation est inconnue ou déjà annulée)
+ * @return l'index du spectacle dans shows[], -1 si la réservation est inconnue
+ */
+int removeBooking(unsigned int booking_id, Message *msg)
+{
+    Booking *booking;
+    int show_index;
+
+    pthread_mutex_lock(&bookings_mutex);
+    if ((booking = (Booking *)lookupTicket(&booking_table, booking_id)) == NULL)
+    {
+        pthread_mutex_unlock(&bookings_mutex);
+        memset(msg, 0, sizeof(Message));
+        return -1;
+    }
+    show_index = booking->show_index;
+    memcpy(msg->show_id, SHOW_ID(show_index), SHOW_ID_LEN);
+    msg->nb_seats = booking->nb_seats;
+    freeTicket(&booking_table, booking);
+    pthread_mutex_unlock(&bookings_mutex);
+    return show_index;
+}
+
+/**
+ * @brief Annule une réservation : les places sont rendues au spectacle
+ *
+ * @param booking_id le numéro de la réservation
+ * @param Message* reçoit le spectacle et le nb de places rendues
+ *                 (tous les bits à 0 si la réservation est inconnue ou déjà annulée)
+ * @return true si la réservation a été annulée
+ */
+bool cancelBooking(unsigned int booking_id, Message *msg)
+{
+    int show_index = removeBooking(booking_id, msg);
+
+    if (show_index == -1)
+    {
+        return false;
+    }
+    returnSeats(show_index, msg->nb_seats);
+    return true;
+}
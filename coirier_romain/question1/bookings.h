@@ -0,0 +1,29 @@
+/*******************************************************************************
+ * @file bookings.h
+ * @brief Réservations (annulables) du serveur de la question 1.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * Chaque réservation acceptée (cf bookSeats()) ou pré-réservation confirmée
+ * est enregistrée dans une table indexée par numéro de réservation (cf ticket_table.h) :
+ * le numéro est renvoyé au client, qui peut ensuite annuler la réservation
+ * en O(1), les places étant immédiatement rendues au spectacle.
+ *
+ * @note une réservation porte sur au moins une place, la table ne contient donc
+ * jamais plus d'éléments que de places vendues et ses emplacements sont recyclés
+ * à chaque annulation : sa mémoire reste bornée.
+ ******************************************************************************/
+
+#ifndef BOOKINGS_H
+#define BOOKINGS_H
+
+#include "common.h"
+
+//prototypes de fonctions
+void initBookings();
+unsigned int recordBooking(int show_index, signed char nb_seats);
+int removeBooking(unsigned int booking_id, Message *msg);
+bool cancelBooking(unsigned int booking_id, Message *msg);
+
+#endif
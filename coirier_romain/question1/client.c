@@ -6,16 +6,23 @@
  * @version 1.0
  * 
  * cf common.h
- * Envoie les requêtes de l'utilisateur (consultation ou réservation) au server,
+ * Envoie les requêtes de l'utilisateur (consultation, réservation, pré-réservation ou annulation) au server,
  *  via une file de message.
  * Reçoit les réponses identifiée avec le PID du client sur la meme queue 
  * 
  * @note Ce client permet de faire de multiples requêtes à la suite 
+ * Les confirmations de liste d'attente (type NOTIFY_TYPE(pid)) sont affichées
+ * avant chaque nouvelle saisie.
+ * 
+ * Les requêtes passent par la bibliothèque client asynchrone (cf client_lib.h) :
+ * sans réponse au bout de RESPONSE_TIMEOUT_MS, la requête est réémise avec
+ * le même identifiant (le serveur ne la traite qu'une fois, cf dedup.h).
  * 
  * @bug ?
  ******************************************************************************/
 
 #include "common.h"
+#include "client_lib.h"
 
 //Variables globales
 int msg_queue_id; // l'identifiant de la file de messages System V
@@ -31,8 +38,10 @@ int getUserRequest(Message *msg);
 void requestShowId(Message *msg);
 int getRequestType(Message *msg);
 void requestNbSeatsToBook(Message *msg);
+unsigned int requestTicket(int request_type);
 
 void displayResponse(Response msg_resp, Request msg_req);
+void displayNotifications(pid_t pid);
 
 /**
  * main()
@@ -48,34 +57,47 @@ int main(void){
     printf("===========================\n");
 
     // variables
-    int return_value;
     pid_t pid = getpid();
-    Request msg_req;
-    Response msg_resp;
+    Message msg;
+    int request_type;
+    unsigned int ticket;
+    Completion completion;
+    int nb_completions;
 
     //mets en place le gestionnaire de signaux ainsi que la file de messages
     initClient();
 
     while(1) {
 
+        // confirmations éventuelles de la liste d'attente
+        displayNotifications(pid);
+
         //préparation de le requete en fonction des choix de l'utilisateur
-        getUserRequest(&msg_req.msg);
+        request_type = getUserRequest(&msg);
+        ticket = 0;
+        if (request_type == REQUEST_CONFIRM || request_type == REQUEST_RELEASE
+            || request_type == REQUEST_CANCEL) {
+            ticket = requestTicket(request_type);
+        }
 
-        //envoi de la requête
-        msg_req.pid = pid; //utilisé pour le type de la réponse
-        msg_req.msg_type = MESSAGE_TYPE;
-        if((return_value = msgsnd(msg_queue_id, &msg_req, sizeof(Request) - sizeof(long), 0)) == -1) {
-            perror("Echec msgsnd.\n");
-            exit(EXIT_FAILURE);
+        //envoi de la requête, réémise jusqu'à MAX_SEND_ATTEMPTS fois
+        if (submitRequest(request_type, &msg, ticket, MAX_SEND_ATTEMPTS * RESPONSE_TIMEOUT_MS, NULL) == 0) {
+            fprintf(stderr, "File de messages pleine, requete non envoyee.\n\n");
+            continue;
         }
 
         //attente de la réponse
-        if((return_value = msgrcv(msg_queue_id, &msg_resp, sizeof(Response) - sizeof(long), (long) pid, 0)) == -1) {
-            perror("Echec msgrcv.\n");
+        while ((nb_completions = waitCompletions(&completion, 1, -1)) == 0);
+        if (nb_completions == -1) {
             exit(EXIT_FAILURE);
         }
-
-        displayResponse(msg_resp, msg_req);
+        if (completion.status == COMPLETION_OK) {
+            displayResponse(completion.response, completion.request);
+        } else if (completion.status == COMPLETION_BUSY) {
+            fprintf(stderr, "Serveur surcharge, requete abandonnee : reessayez plus tard.\n\n");
+        } else {
+            fprintf(stderr, "Serveur injoignable, requete abandonnee.\n\n");
+        }
     }
 }
 
@@ -99,7 +121,7 @@ void sigint_handler(int sig) {
 
 /**
  * @brief Mets en place les handlers de signaux pour le process.
- * ici uniquement SIGINT
+ * SIGINT (SIGALRM est géré par la bibliothèque client)
  */
 void setupSignalHandlers() {
 
@@ -156,6 +178,11 @@ void initClient() {
 
     // Initialisation de la file de messages avec la clef générée
     setupMsgQueue(key);
+
+    // bibliothèque client (requêtes en vol, réémissions)
+    if (!initClientLib(key)) {
+        exit(EXIT_FAILURE);
+    }
 }
 
 
@@ -171,6 +198,23 @@ void initClient() {
  */
 void displayResponse(Response msg_resp, Request msg_req) {
     
+    if (msg_req.request_type == REQUEST_CONFIRM || msg_req.request_type == REQUEST_RELEASE
+        || msg_req.request_type == REQUEST_CANCEL) {
+        // Confirmation / libération / annulation : un ticket à 0 indique un ticket inconnu
+        if (msg_resp.ticket == 0) {
+            printf("Le serveur indique que le ticket %u n existe pas ou a expire.\n\n",
+                msg_req.ticket);
+        } else if (msg_req.request_type == REQUEST_CONFIRM) {
+            printf("Reservation confirmee de %d places pour le spectacle %s (reservation %u).\n\n",
+                msg_resp.msg.nb_seats, msg_resp.msg.show_id, msg_resp.ticket);
+        } else {
+            printf("%s de %d places pour le spectacle %s (ticket %u).\n\n",
+                msg_req.request_type == REQUEST_CANCEL ? "Annulation et remboursement" : "Liberation",
+                msg_resp.msg.nb_seats, msg_resp.msg.show_id, msg_resp.ticket);
+        }
+        return;
+    }
+
     //si la structure est remplie de 0, le server indique que le show n'existe pas
     if (msg_resp.msg.show_id[0] == '\0') {        
         printf("Le serveur indique que le spectacle %s n existe pas.\n\n",
@@ -178,15 +222,29 @@ void displayResponse(Response msg_resp, Request msg_req) {
         return;
     }
 
-    if (msg_req.msg.nb_seats == 0) {
+    if (msg_req.request_type == REQUEST_CONSULT) {
         // Requête de consultation
         printf("Il reste %d places libres pour le spectacle %s.\n\n", 
             msg_resp.msg.nb_seats, msg_resp.msg.show_id);
+    } else if (msg_req.request_type == REQUEST_HOLD) {
+        // Requête de pré-réservation
+        if (msg_resp.ticket != 0) {
+            printf("Pre-reservation de %d places pour le spectacle %s : ticket %u (valable %d s).\n\n",
+                msg_resp.msg.nb_seats, msg_resp.msg.show_id, msg_resp.ticket, HOLD_TTL_SEC);
+        } else {
+            printf("Pre-reservation impossible de %d places ; %d disponibles pour le spectacle %s.\n\n", 
+                msg_req.msg.nb_seats, -1 * msg_resp.msg.nb_seats, msg_resp.msg.show_id);
+        }
+    } else if (msg_resp.status == STATUS_WAITLISTED) {
+        // Réservation refusée mais placée en liste d'attente
+        printf("Reservation impossible de %d places ; %d disponibles pour le spectacle %s.\n\
+Demande placee en liste d'attente, la confirmation arrivera plus tard.\n\n",
+            msg_req.msg.nb_seats, -1 * msg_resp.msg.nb_seats, msg_resp.msg.show_id);
     } else {
         // Requête de réservation
         if (msg_resp.msg.nb_seats > 0) {
-            printf("Reservation confirmee de %d places pour le spectacle %s.\n\n",
-                msg_resp.msg.nb_seats, msg_resp.msg.show_id);
+            printf("Reservation confirmee de %d places pour le spectacle %s (reservation %u).\n\n",
+                msg_resp.msg.nb_seats, msg_resp.msg.show_id, msg_resp.ticket);
         } else {
             printf("Reservation impossible de %d places ; %d disponibles pour le spectacle %s.\n\n", 
                 msg_req.msg.nb_seats, -1 * msg_resp.msg.nb_seats, msg_resp.msg.show_id);
@@ -195,6 +253,23 @@ void displayResponse(Response msg_resp, Request msg_req) {
 }
 
 
+/**
+ * @brief Affiche les confirmations de liste d'attente reçues depuis la dernière saisie.
+ *
+ * Lecture non bloquante des messages de type NOTIFY_TYPE(pid).
+ *
+ * @param pid le pid du client
+ */
+void displayNotifications(pid_t pid) {
+    Response msg_notify;
+
+    while (msgrcv(msg_queue_id, &msg_notify, sizeof(Response) - sizeof(long),
+        NOTIFY_TYPE(pid), IPC_NOWAIT) != -1) {
+        printf("Liste d'attente : reservation confirmee de %d places pour le spectacle %s (reservation %u).\n\n",
+            msg_notify.msg.nb_seats, msg_notify.msg.show_id, msg_notify.ticket);
+    }
+}
+
 /**
  * @brief Rempli la structure de message à envoyer.
  *
@@ -202,7 +277,7 @@ void displayResponse(Response msg_resp, Request msg_req) {
  * pour remplir le message de sa requête.
  *
  * @param msg une structure de message à remplir (par reference).
- * @return type de requete : REQUETE_CONSULT ou REQUETE_RESA.
+ * @return type de requete : REQUEST_CONSULT, REQUEST_RESA, REQUEST_HOLD...
  */
 int getUserRequest(Message *msg)
 {
@@ -214,19 +289,22 @@ int getUserRequest(Message *msg)
     while (!is_valid_input)
     {
         request_type = getRequestType(msg);
-        if (request_type == REQUEST_RESA)
+        if (request_type == REQUEST_RESA || request_type == REQUEST_HOLD
+            || request_type == REQUEST_WAITLIST)
         {
-            // requete de réservation => on demande le nb de places
+            // requete de (pré-)réservation => on demande le nb de places
             is_valid_input = true;
             requestNbSeatsToBook(msg);
         }
-        else if (request_type == REQUEST_CONSULT)
+        else if (request_type == REQUEST_CONSULT || request_type == REQUEST_CONFIRM
+            || request_type == REQUEST_RELEASE || request_type == REQUEST_CANCEL)
         {
             is_valid_input = true;
+            msg->nb_seats = 0;
         }
         else
         {
-            // la requête saisie n'est ni REQUEST_RESA ni REQUEST_CONSULT
+            // la requête saisie n'est pas un type connu
             fprintf(stderr, "Saisie non valide.\n");
         }
     }
@@ -289,7 +367,7 @@ void requestShowId(Message *msg)
  * de saisir un type de requête valide.
  *
  * @param msg Une structure de message contenant l'identifiant du spectacle.
- * @return Le type de requête : REQUEST_CONSULT ou REQUEST_RESA.
+ * @return Le type de requête : REQUEST_CONSULT, REQUEST_RESA, REQUEST_HOLD...
  */
 int getRequestType(Message *msg)
 {
@@ -300,8 +378,11 @@ int getRequestType(Message *msg)
     while (!is_valid_input)
     {
         printf("Choisissez votre requete pour %s\n \
-(%d)-> Consultation, (%d)-> Reservation :\n",
-               msg->show_id, REQUEST_CONSULT, REQUEST_RESA);
+(%d)-> Consultation, (%d)-> Reservation, (%d)-> Pre-reservation,\n \
+(%d)-> Confirmation d'un ticket, (%d)-> Liberation d'un ticket,\n \
+(%d)-> Annulation d'une reservation, (%d)-> Reservation avec liste d'attente :\n",
+               msg->show_id, REQUEST_CONSULT, REQUEST_RESA, REQUEST_HOLD,
+               REQUEST_CONFIRM, REQUEST_RELEASE, REQUEST_CANCEL, REQUEST_WAITLIST);
         if (scanf("%d", &request_type) == 1)
         {
             is_valid_input = true;
@@ -349,4 +430,35 @@ void requestNbSeatsToBook(Message *msg)
     }
 
     msg->nb_seats = (signed char)nb_seats;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Demande à l'utilisateur de saisir le ticket d'une pré-réservation
+ *  ou le numéro d'une réservation (annulation).
+ *
+ * @param request_type le type de la requête en cours
+ * @return Le numéro de ticket saisi (strictement positif).
+ */
+unsigned int requestTicket(int request_type)
+{
+    bool is_valid_input = false;
+    unsigned int ticket;
+
+    // Demande un ticket tant que la saisie n'est pas valide
+    while (!is_valid_input)
+    {
+        printf("Saisissez le numero %s :\n",
+            request_type == REQUEST_CANCEL ? "de la reservation" : "de ticket de la pre-reservation");
+        if ((scanf("%u", &ticket) == 1) && (ticket > 0))
+        {
+            is_valid_input = true;
+        }
+        else
+        {
+            fprintf(stderr, "Saisie non valide.\n");
+            // Vide le buffer d'entrée pour éviter une boucle infinie
+            while (getchar() != '\n');
+        }
+    }
+    return ticket;
+}
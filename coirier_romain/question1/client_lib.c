@@ -0,0 +1,329 @@
+/*******************************************************************************
+ * @file client_lib.c
+ * @brief Implémentation de la bibliothèque client asynchrone de la question 1.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * cf client_lib.h
+ * Les requêtes en vol sont rangées dans une table indexée par ticket
+ * (cf ticket_table.h) : l'identifiant de requête envoyé au serveur est
+ * le ticket masqué par un sel tiré au démarrage, la réponse retrouve donc
+ * sa requête en O(1), et un nouveau client ayant le même pid ne produit pas
+ * les mêmes identifiants que le précédent.
+ *
+ * Réémissions et échéances sont gérées par une roue de temporisation
+ * (cf timer_wheel.h) au tick de CLIENT_TICK_MS.
+ ******************************************************************************/
+
+#include "client_lib.h"
+#include "ticket_table.h"
+#include "timer_wheel.h"
+
+#include <time.h>
+
+#define WAIT_SLICE_MS 10 // durée max d'une attente bloquante dans msgrcv
+
+typedef struct {
+    TicketSlot slot; // en-tête de la table des tickets
+    TimerEntry timer; // prochaine réémission ou échéance
+    unsigned long deadline; // échéance de la requête (ticks)
+    bool busy; // dernière réponse : serveur saturé
+    Request msg_req; // la requête, conservée pour la réémission
+    void *user_data;
+} PendingRequest;
+
+// variables du module
+static int lib_queue_id; // l'identifiant de la file de messages System V
+static pid_t lib_pid;
+static unsigned int id_salt; // masque des identifiants de requête
+static TicketTable pending_table; // requêtes en vol
+static TimerWheel deadline_wheel;
+
+/**
+ * @brief Renvoie le tick courant (horloge monotone)
+ */
+static unsigned long currentTick()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec * 1000UL + now.tv_nsec / 1000000) / CLIENT_TICK_MS;
+}
+
+/**
+ * @brief Handler de SIGALRM : interrompt simplement l'attente dans msgrcv (EINTR)
+ */
+static void sigalrmHandler(int sig)
+{
+}
+
+/**
+ * @brief Arme (ou désarme avec 0) l'alarme de l'attente bloquante
+ */
+static void armAlarm(int delay_ms)
+{
+    struct itimerval timer;
+
+    memset(&timer, 0, sizeof(timer));
+    timer.it_value.tv_sec = delay_ms / 1000;
+    timer.it_value.tv_usec = (delay_ms % 1000) * 1000;
+    setitimer(ITIMER_REAL, &timer, NULL);
+}
+
+/**
+ * @brief Arme la prochaine réémission de la requête, ou son échéance si elle est plus proche
+ */
+static void armPending(PendingRequest *pending, unsigned long now)
+{
+    unsigned long next = now + RESPONSE_TIMEOUT_MS / CLIENT_TICK_MS;
+
+    addTimer(&deadline_wheel, &pending->timer,
+        ((long)(next - pending->deadline) < 0) ? next : pending->deadline);
+}
+
+/**
+ * @brief Initialise la bibliothèque : file de messages, tables et handler de SIGALRM
+ *
+ * @param key la clef IPC de la file de messages du serveur
+ * @return true si la file de messages est disponible
+ */
+bool initClientLib(key_t key)
+{
+    struct sigaction sa;
+    struct timespec now;
+
+    if ((lib_queue_id = msgget(key, 0666 | IPC_CREAT)) == -1)
+    {
+        perror("Recuperation de la file de messages : Echec.\n");
+        return false;
+    }
+    lib_pid = getpid();
+
+    // handler d'alarme, sans SA_RESTART pour interrompre msgrcv
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = sigalrmHandler;
+    sa.sa_flags = 0;
+    if (sigaction(SIGALRM, &sa, NULL) == -1)
+    {
+        perror("Erreur sigaction.\n");
+        return false;
+    }
+
+    clock_gettime(CLOCK_REALTIME, &now);
+    id_salt = (unsigned int)(now.tv_nsec ^ (now.tv_sec << 16) ^ ((unsigned int)lib_pid << 8));
+    initTicketTable(&pending_table, sizeof(PendingRequest), MAX_TICKETS);
+    initTimerWheel(&deadline_wheel, currentTick());
+    return true;
+}
+
+/**
+ * @brief Envoie une requête sans attendre sa réponse
+ *
+ * @param request_type le type de requête (REQUEST_CONSULT, REQUEST_RESA...)
+ * @param msg le spectacle et le nb de places
+ * @param target_ticket la (pré-)réservation visée (confirmation, libération, annulation)
+ * @param deadline_ms délai avant abandon (<= 0 : MAX_SEND_ATTEMPTS réémissions)
+ * @param user_data donnée de l'appelant, rendue avec la complétion
+ * @return le ticket de la requête, 0 si elle n'a pas pu être envoyée
+ *         (file de messages pleine : à resoumettre plus tard)
+ */
+unsigned int submitRequest(int request_type, const Message *msg, unsigned int target_ticket,
+    int deadline_ms, void *user_data)
+{
+    PendingRequest *pending;
+    unsigned long now = currentTick();
+
+    if ((pending = (PendingRequest *)allocTicket(&pending_table)) == NULL)
+    {
+        return 0;
+    }
+    if ((pending->slot.id ^ id_salt) == 0)
+    {
+        // identifiant nul réservé aux requêtes sans identifiant
+        PendingRequest *other = (PendingRequest *)allocTicket(&pending_table);
+        freeTicket(&pending_table, pending);
+        if ((pending = other) == NULL)
+        {
+            return 0;
+        }
+    }
+    if (deadline_ms <= 0)
+    {
+        deadline_ms = MAX_SEND_ATTEMPTS * RESPONSE_TIMEOUT_MS;
+    }
+
+    pending->msg_req.msg_type = MESSAGE_TYPE;
+    pending->msg_req.msg = *msg;
+    pending->msg_req.pid = lib_pid; //utilisé pour le type de la réponse
+    pending->msg_req.request_type = request_type;
+    pending->msg_req.ticket = target_ticket;
+    pending->msg_req.request_id = pending->slot.id ^ id_salt;
+    pending->user_data = user_data;
+    pending->deadline = now + deadline_ms / CLIENT_TICK_MS;
+    pending->busy = false;
+
+    // envoi sans attente : une file pleine est signalée à l'appelant
+    if (msgsnd(lib_queue_id, &pending->msg_req, sizeof(Request) - sizeof(long), IPC_NOWAIT) == -1)
+    {
+        if (errno != EAGAIN)
+        {
+            perror("Echec msgsnd.\n");
+        }
+        freeTicket(&pending_table, pending);
+        return 0;
+    }
+    armPending(pending, now);
+    return pending->slot.id;
+}
+
+/**
+ * @brief Termine la requête d'une réponse reçue
+ *
+ * Une réponse STATUS_BUSY ne termine pas la requête : sa réémission est
+ * repoussée au délai indiqué par le serveur (borné par l'échéance)
+ *
+ * @return true si la réponse termine une requête en vol
+ *         (false : réponse en double d'une requête déjà terminée, ou refus)
+ */
+static bool completeResponse(const Response *msg_resp, Completion *completion)
+{
+    PendingRequest *pending;
+
+    if ((pending = (PendingRequest *)lookupTicket(&pending_table, msg_resp->request_id ^ id_salt)) == NULL)
+    {
+        return false;
+    }
+    if (msg_resp->status == STATUS_BUSY)
+    {
+        unsigned long next = currentTick() + msg_resp->retry_after_ms / CLIENT_TICK_MS;
+
+        pending->busy = true;
+        cancelTimer(&pending->timer);
+        addTimer(&deadline_wheel, &pending->timer,
+            ((long)(next - pending->deadline) < 0) ? next : pending->deadline);
+        return false;
+    }
+    completion->ticket = pending->slot.id;
+    completion->status = COMPLETION_OK;
+    completion->request = pending->msg_req;
+    completion->response = *msg_resp;
+    completion->user_data = pending->user_data;
+    cancelTimer(&pending->timer);
+    freeTicket(&pending_table, pending);
+    return true;
+}
+
+/**
+ * @brief Traite les temporisations échues : réémission ou abandon
+ *
+ * @return le nb de complétions (abandons) produites, max au plus
+ */
+static int processTimers(Completion *completions, int max)
+{
+    unsigned long now = currentTick();
+    TimerEntry expired;
+    int nb_completions = 0;
+
+    initTimerList(&expired);
+    advanceTimerWheel(&deadline_wheel, now, &expired);
+    while (!isTimerListEmpty(&expired))
+    {
+        PendingRequest *pending = (PendingRequest *)((char *)expired.next - offsetof(PendingRequest, timer));
+        cancelTimer(&pending->timer);
+
+        if ((long)(now - pending->deadline) < 0)
+        {
+            // réémission avec le même identifiant
+            msgsnd(lib_queue_id, &pending->msg_req, sizeof(Request) - sizeof(long), IPC_NOWAIT);
+            armPending(pending, now);
+        }
+        else if (nb_completions == max)
+        {
+            // plus de place pour les complétions : au prochain appel
+            addTimer(&deadline_wheel, &pending->timer, now);
+        }
+        else
+        {
+            // échéance dépassée : abandon
+            Completion *completion = &completions[nb_completions++];
+            completion->ticket = pending->slot.id;
+            completion->status = pending->busy ? COMPLETION_BUSY : COMPLETION_TIMEOUT;
+            completion->request = pending->msg_req;
+            completion->user_data = pending->user_data;
+            freeTicket(&pending_table, pending);
+        }
+    }
+    return nb_completions;
+}
+
+/**
+ * @brief Renvoie, sans bloquer, les requêtes terminées
+ *
+ * @param completions reçoit les complétions
+ * @param max le nb max de complétions
+ * @return le nb de complétions
+ */
+int pollCompletions(Completion *completions, int max)
+{
+    Response msg_resp;
+    int nb_completions = 0;
+
+    while (nb_completions < max
+        && msgrcv(lib_queue_id, &msg_resp, sizeof(Response) - sizeof(long), (long)lib_pid, IPC_NOWAIT) != -1)
+    {
+        if (completeResponse(&msg_resp, &completions[nb_completions]))
+        {
+            nb_completions++;
+        }
+    }
+    return nb_completions + processTimers(completions + nb_completions, max - nb_completions);
+}
+
+/**
+ * @brief Attend qu'au moins une requête se termine
+ *
+ * @param completions reçoit les complétions
+ * @param max le nb max de complétions
+ * @param timeout_ms durée max d'attente (< 0 : jusqu'à une complétion)
+ * @return le nb de complétions (0 : délai écoulé ou aucune requête en vol),
+ *         -1 si la file de messages n'est plus disponible
+ */
+int waitCompletions(Completion *completions, int max, int timeout_ms)
+{
+    unsigned long end = currentTick() + timeout_ms / CLIENT_TICK_MS;
+    Response msg_resp;
+    int nb_completions;
+
+    while ((nb_completions = pollCompletions(completions, max)) == 0 && getNbInFlight() > 0)
+    {
+        if (timeout_ms >= 0 && (long)(currentTick() - end) >= 0)
+        {
+            break;
+        }
+        // attente bloquante d'une réponse, interrompue pour traiter les temporisations
+        armAlarm(WAIT_SLICE_MS);
+        int return_value = msgrcv(lib_queue_id, &msg_resp, sizeof(Response) - sizeof(long), (long)lib_pid, 0);
+        armAlarm(0);
+        if (return_value == -1)
+        {
+            if (errno != EINTR)
+            {
+                perror("Echec msgrcv.\n");
+                return -1;
+            }
+        }
+        else if (completeResponse(&msg_resp, &completions[0]))
+        {
+            return 1 + pollCompletions(completions + 1, max - 1);
+        }
+    }
+    return nb_completions;
+}
+
+/**
+ * @brief Renvoie le nb de requêtes en vol
+ */
+int getNbInFlight()
+{
+    return pending_table.nb_used;
+}
@@ -0,0 +1,55 @@
+/*******************************************************************************
+ * @file client_lib.h
+ * @brief Bibliothèque client asynchrone de la question 1.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * Permet à un même process de garder de nombreuses requêtes en vol :
+ * -> submitRequest() envoie la requête sans attendre et renvoie un ticket
+ * -> pollCompletions() (non bloquant) ou waitCompletions() (bloquant, borné)
+ *    renvoient les requêtes terminées, réponse ou délai dépassé.
+ *
+ * Les réponses sont associées à leur requête par l'identifiant de requête
+ * (et non seulement par le pid). Sans réponse au bout de RESPONSE_TIMEOUT_MS,
+ * la requête est réémise avec le même identifiant (cf dedup.h côté serveur),
+ * jusqu'à son échéance propre, fixée à la soumission.
+ * Une requête refusée par un serveur saturé (STATUS_BUSY) est réémise après
+ * le délai indiqué par le serveur ; refusée jusqu'à son échéance,
+ * elle se termine en COMPLETION_BUSY.
+ *
+ * @note la bibliothèque installe un handler de SIGALRM (attente bornée de msgrcv)
+ * et n'est pas prévue pour être appelée depuis plusieurs threads.
+ ******************************************************************************/
+
+#ifndef CLIENT_LIB_H
+#define CLIENT_LIB_H
+
+#include "common.h"
+
+#define CLIENT_TICK_MS 1 // résolution des échéances
+
+// Issue d'une requête
+typedef enum {
+    COMPLETION_OK, // réponse reçue
+    COMPLETION_TIMEOUT, // échéance dépassée sans réponse
+    COMPLETION_BUSY // échéance dépassée, serveur saturé (dernière réponse STATUS_BUSY)
+} CompletionStatus;
+
+typedef struct {
+    unsigned int ticket; // ticket renvoyé par submitRequest()
+    CompletionStatus status;
+    Request request; // la requête envoyée
+    Response response; // la réponse (COMPLETION_OK uniquement)
+    void *user_data; // donnée de l'appelant fournie à la soumission
+} Completion;
+
+//prototypes de fonctions
+bool initClientLib(key_t key);
+unsigned int submitRequest(int request_type, const Message *msg, unsigned int target_ticket,
+    int deadline_ms, void *user_data);
+int pollCompletions(Completion *completions, int max);
+int waitCompletions(Completion *completions, int max, int timeout_ms);
+int getNbInFlight();
+
+#endif
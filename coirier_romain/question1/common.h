@@ -16,6 +16,22 @@
  *     > 0 en consultation : réponse ; en réservation : demande / accusé
  *     < 0 en réservation refus avec indication des places restantes
  * 
+ * Le type de requête est porté par le champ request_type de la requête.
+ * Une pré-réservation (REQUEST_HOLD) bloque les places pendant HOLD_TTL_SEC secondes,
+ * le serveur renvoie un numéro de ticket à fournir pour la confirmer ou la libérer.
+ * Une réservation acceptée (ou une pré-réservation confirmée) renvoie un numéro de réservation
+ * dans le champ ticket, à fournir pour l'annuler (REQUEST_CANCEL).
+ * Un ticket à 0 dans la réponse signifie qu'aucune (pré-)réservation n'a été faite / trouvée.
+ * Une réservation REQUEST_WAITLIST refusée est mise en liste d'attente (status STATUS_WAITLISTED) :
+ * sa confirmation arrive plus tard, avec le type NOTIFY_TYPE(pid) au lieu du pid.
+ * 
+ * Chaque requête porte un identifiant (request_id, unique par client, 0 : aucun)
+ * recopié dans la réponse : une requête réémise avec le même identifiant
+ * n'est traitée qu'une fois par le serveur (cf dedup.h).
+ * 
+ * Un serveur saturé refuse la requête sans la traiter (status STATUS_BUSY),
+ * le client peut la réémettre après retry_after_ms (cf admission.h).
+ * 
  * @bug .
  ******************************************************************************/
 
@@ -35,6 +51,7 @@
 
 //signaux
 #include <signal.h>
+#include <sys/time.h>
 
 //message queue
 #include <sys/msg.h>
@@ -53,6 +70,24 @@
 #define MESSAGE_TYPE 1
 #define REQUEST_CONSULT 1 // requête en consultation
 #define REQUEST_RESA 2 // requête en réservation
+#define REQUEST_HOLD 3 // requête en pré-réservation (places bloquées temporairement)
+#define REQUEST_CONFIRM 4 // confirmation d'une pré-réservation
+#define REQUEST_RELEASE 5 // libération d'une pré-réservation
+#define REQUEST_CANCEL 6 // annulation d'une réservation (places rendues)
+#define REQUEST_WAITLIST 7 // réservation, mise en liste d'attente si refusée
+
+#define STATUS_OK 0 // requête traitée
+#define STATUS_WAITLISTED 1 // réservation en liste d'attente, confirmation envoyée plus tard
+#define STATUS_BUSY 2 // serveur saturé, requête non traitée : réémettre après retry_after_ms
+
+// type des confirmations de liste d'attente envoyées au client
+// (au delà des pid possibles, pour ne pas les confondre avec les réponses)
+#define NOTIFY_TYPE(pid) ((long)(pid) + (1L << 22))
+
+#define HOLD_TTL_SEC 60 // durée de vie d'une pré-réservation non confirmée
+
+#define RESPONSE_TIMEOUT_MS 2000 // délai d'attente d'une réponse par le client
+#define MAX_SEND_ATTEMPTS 4 // nb d'envois d'une même requête avant abandon
 
 // Tableau des noms de spectacles (6 caractères exactement)
 static const char *const SHOW_IDS[] = {
@@ -73,11 +108,18 @@ typedef struct {
     long msg_type;
     Message msg;
     pid_t pid;
+    int request_type; // REQUEST_CONSULT, REQUEST_RESA, REQUEST_HOLD...
+    unsigned int ticket; // (pré-)réservation visée (confirmation / libération / annulation)
+    unsigned int request_id; // identifiant de la requête, identique en cas de réémission
 } Request;
 
 typedef struct {
     long msg_type;
     Message msg;
+    unsigned int ticket; // (pré-)réservation attribuée / traitée (0 : aucune)
+    int status; // STATUS_OK, STATUS_WAITLISTED, STATUS_BUSY
+    unsigned int request_id; // identifiant de la requête traitée
+    int retry_after_ms; // délai de réémission conseillé (STATUS_BUSY)
 } Response;
 
 //prototypes de fonctions
@@ -1,8 +1,8 @@
 #!/bin/bash
 
 # Sources
-CLIENT_SRC="client.c" 
-SERVER_SRC="server.c"
+CLIENT_SRC="client.c client_lib.c ticket_table.c timer_wheel.c"
+SERVER_SRC="server.c show_table.c holds.c bookings.c waitlist.c dedup.c rate_limit.c admission.c stats.c scheduler.c coroutine.c slab.c request_pool.c perf_counters.c lock_profile.c pending_replies.c ticket_table.c timer_wheel.c"
 
 # Executables
 CLIENT_OUT="client"
@@ -10,6 +10,7 @@ SERVER_OUT="server"
 
 # Compilation
 GCC_FLAGS= "" #"-Wall -Werror"
+LAYOUT_FLAGS="" #"-DSEAT_TABLE_SOA" : compteurs de places alignés sur des lignes de cache
 echo "Compilation du client..."
 gcc $GCC_FLAGS -o $CLIENT_OUT $CLIENT_SRC
 if [$? -ne 0]; then
@@ -18,7 +19,7 @@ if [$? -ne 0]; then
 fi
 
 echo "Compilation serveur..."
-gcc $GCC_FLAGS -o $SERVER_OUT $SERVER_SRC
+gcc $GCC_FLAGS $LAYOUT_FLAGS -o $SERVER_OUT $SERVER_SRC
 if [$? -ne 0]; then
     echo "Echec de la compilation du serveur."
     exit 1
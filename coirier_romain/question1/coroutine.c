@@ -0,0 +1,277 @@
+/*******************************************************************************
+ * @file coroutine.c
+ * @brief Implémentation du traitement en coroutines de la question 1.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * cf coroutine.h
+ * Chaque thread de traitement garde l'anneau de ses coroutines en cours et
+ * les reprend à tour de rôle (swapcontext) ; une coroutine suspendue rend
+ * la main au thread, une coroutine terminée revient à lui par uc_link.
+ * Les coroutines (pile comprise) sont allouées dans une réserve d'objets (cf slab.h) :
+ * une coroutine terminée est reprise, sans malloc, par une requête suivante du même thread.
+ ******************************************************************************/
+
+#include "coroutine.h"
+#include "slab.h"
+
+#include <ucontext.h>
+
+typedef struct Coroutine {
+    ucontext_t context;
+    Task *task; // requête traitée
+    bool finished;
+    struct Coroutine *next; // suivante dans l'anneau des coroutines en cours
+    char stack[COROUTINE_STACK_SIZE];
+} Coroutine;
+
+// Etat d'un thread de traitement en mode coroutines
+typedef struct {
+    ucontext_t context; // boucle de reprise du thread
+    Coroutine *current; // coroutine en cours d'exécution (NULL : aucune)
+    void (*handler)(Task *task);
+    unsigned long nb_progress; // opérations abouties après une suspension
+} WorkerContext;
+
+// variables du module
+static __thread WorkerContext *worker_context; // NULL hors thread de traitement en coroutines
+static Slab coroutine_slab;
+static unsigned long nb_started;
+static unsigned long nb_live;
+static unsigned long peak_live;
+static unsigned long nb_suspensions;
+
+/**
+ * @brief Point d'entrée d'une coroutine : traitement de sa requête
+ */
+static void coroutineEntry()
+{
+    Coroutine *coroutine = worker_context->current;
+
+    worker_context->handler(coroutine->task);
+    coroutine->finished = true;
+    // retour à la boucle du thread par uc_link
+}
+
+/**
+ * @brief Suspend la coroutine en cours, reprise au prochain tour de son thread
+ */
+static void yieldCoroutine()
+{
+    __atomic_add_fetch(&nb_suspensions, 1, __ATOMIC_RELAXED);
+    swapcontext(&worker_context->current->context, &worker_context->context);
+}
+
+/**
+ * @brief Prépare la réserve des coroutines (avant le lancement des threads)
+ *
+ * @param nb_workers le nb de threads de traitement
+ */
+void initCoroutines(int nb_workers)
+{
+    initSlab(&coroutine_slab, "coroutines", sizeof(Coroutine),
+        (unsigned long)nb_workers * COROUTINES_PER_WORKER);
+}
+
+/**
+ * @brief Prépare une coroutine pour une requête
+ */
+static Coroutine *startCoroutine(Task *task)
+{
+    Coroutine *coroutine = (Coroutine *)slabAlloc(&coroutine_slab);
+
+    if (coroutine == NULL)
+    {
+        perror("Echec allocation d'une coroutine.\n");
+        exit(EXIT_FAILURE);
+    }
+    __atomic_add_fetch(&nb_started, 1, __ATOMIC_RELAXED);
+    getcontext(&coroutine->context);
+    coroutine->context.uc_stack.ss_sp = coroutine->stack;
+    coroutine->context.uc_stack.ss_size = COROUTINE_STACK_SIZE;
+    coroutine->context.uc_link = &worker_context->context;
+    makecontext(&coroutine->context, coroutineEntry, 0);
+    coroutine->task = task;
+    coroutine->finished = false;
+    coroutine->next = NULL;
+
+    unsigned long live = __atomic_add_fetch(&nb_live, 1, __ATOMIC_RELAXED);
+    if (live > peak_live)
+    {
+        __atomic_store_n(&peak_live, live, __ATOMIC_RELAXED);
+    }
+    return coroutine;
+}
+
+/**
+ * @brief Boucle d'un thread de traitement en mode coroutines (ne rend pas la main)
+ *
+ * Démarre une coroutine par requête disponible, puis reprend une fois chaque
+ * coroutine en cours ; sans requête ni coroutine, attend une requête.
+ *
+ * @param worker l'index du thread (cf scheduler.h)
+ * @param handler la fonction de traitement d'une requête
+ */
+void runCoroutineWorker(int worker, void (*handler)(Task *task))
+{
+    WorkerContext context;
+    Coroutine *head = NULL; // anneau des coroutines en cours
+    Coroutine *tail = NULL;
+    int nb_running = 0;
+    Task *task;
+
+    memset(&context, 0, sizeof(context));
+    context.handler = handler;
+    worker_context = &context;
+
+    while (1)
+    {
+        bool progress = false;
+        unsigned long nb_progress = context.nb_progress;
+
+        // une coroutine par nouvelle requête
+        while (nb_running < COROUTINES_PER_WORKER && (task = takeTask(worker)) != NULL)
+        {
+            Coroutine *coroutine = startCoroutine(task);
+            if (head == NULL)
+            {
+                head = coroutine;
+            }
+            else
+            {
+                tail->next = coroutine;
+            }
+            tail = coroutine;
+            nb_running++;
+            progress = true;
+        }
+        if (nb_running == 0)
+        {
+            waitForTask();
+            continue;
+        }
+
+        // un tour de reprise des coroutines en cours
+        for (int i = nb_running; i > 0; i--)
+        {
+            Coroutine *coroutine = head;
+            head = coroutine->next;
+            coroutine->next = NULL;
+            if (head == NULL)
+            {
+                tail = NULL;
+            }
+
+            context.current = coroutine;
+            swapcontext(&context.context, &coroutine->context);
+            context.current = NULL;
+
+            if (coroutine->finished)
+            {
+                slabFree(&coroutine_slab, coroutine);
+                nb_running--;
+                __atomic_sub_fetch(&nb_live, 1, __ATOMIC_RELAXED);
+                progress = true;
+            }
+            else
+            {
+                // suspendue : en fin d'anneau
+                if (head == NULL)
+                {
+                    head = coroutine;
+                }
+                else
+                {
+                    tail->next = coroutine;
+                }
+                tail = coroutine;
+            }
+        }
+        if (!progress && context.nb_progress == nb_progress)
+        {
+            // toutes les coroutines attendent : on laisse avancer les autres threads
+            usleep(COROUTINE_POLL_US);
+        }
+    }
+}
+
+/**
+ * @brief Opérations sur un tableau de sémaphores, coroutine suspendue tant qu'elles bloqueraient
+ *
+ * Hors coroutine : équivalent à semop()
+ *
+ * @return le résultat de semop()
+ */
+int semopYield(int semset_id, struct sembuf *operations, int nb_operations)
+{
+    bool waited = false;
+    int return_value;
+
+    if (worker_context == NULL || worker_context->current == NULL)
+    {
+        return semop(semset_id, operations, nb_operations);
+    }
+    for (int i = 0; i < nb_operations; i++)
+    {
+        operations[i].sem_flg |= IPC_NOWAIT;
+    }
+    while ((return_value = semop(semset_id, operations, nb_operations)) == -1 && errno == EAGAIN)
+    {
+        waited = true;
+        yieldCoroutine();
+    }
+    for (int i = 0; i < nb_operations; i++)
+    {
+        operations[i].sem_flg &= ~IPC_NOWAIT;
+    }
+    if (waited && return_value == 0)
+    {
+        worker_context->nb_progress++;
+    }
+    return return_value;
+}
+
+/**
+ * @brief Envoi d'un message, coroutine suspendue tant que la file est pleine
+ *
+ * Hors coroutine : équivalent à msgsnd() (attente sur file pleine)
+ *
+ * @return le résultat de msgsnd()
+ */
+int msgsndYield(int queue_id, const void *msg, size_t msg_size)
+{
+    bool waited = false;
+    int return_value;
+
+    if (worker_context == NULL || worker_context->current == NULL)
+    {
+        return msgsnd(queue_id, msg, msg_size, 0);
+    }
+    while ((return_value = msgsnd(queue_id, msg, msg_size, IPC_NOWAIT)) == -1 && errno == EAGAIN)
+    {
+        waited = true;
+        yieldCoroutine();
+    }
+    if (waited && return_value == 0)
+    {
+        worker_context->nb_progress++;
+    }
+    return return_value;
+}
+
+/**
+ * @brief Affiche les compteurs des coroutines
+ */
+void printCoroutineStats()
+{
+    unsigned long started = __atomic_load_n(&nb_started, __ATOMIC_RELAXED);
+
+    if (started == 0)
+    {
+        return;
+    }
+    printf("Coroutines : %lu en cours (pic %lu), %lu lancees, %lu suspensions.\n",
+        __atomic_load_n(&nb_live, __ATOMIC_RELAXED), __atomic_load_n(&peak_live, __ATOMIC_RELAXED),
+        started, __atomic_load_n(&nb_suspensions, __ATOMIC_RELAXED));
+}
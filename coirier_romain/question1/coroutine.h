@@ -0,0 +1,49 @@
+/*******************************************************************************
+ * @file coroutine.h
+ * @brief Traitement des requêtes en coroutines du serveur de la question 1.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * Mode coroutines (option -C du serveur) : chaque requête est traitée par une
+ * coroutine (contexte ucontext et pile de COROUTINE_STACK_SIZE octets) et non
+ * plus en bloquant un thread de traitement. Chaque thread fait avancer à tour
+ * de rôle jusqu'à COROUTINES_PER_WORKER coroutines ; une coroutine se suspend,
+ * au lieu de bloquer son thread, sur :
+ * -> l'attente des sémaphores des sections critiques (semopYield())
+ * -> l'attente de place dans la file de messages pour la réponse (msgsndYield())
+ * Des dizaines de milliers de requêtes en cours coûtent ainsi quelques dizaines
+ * de Ko chacune au lieu d'une pile de thread.
+ *
+ * Une opération qui ne peut aboutir est réessayée quand la coroutine reprend la main ;
+ * quand aucune coroutine du thread n'a avancé pendant un tour, le thread dort
+ * COROUTINE_POLL_US (un sémaphore System V ne peut pas être attendu sans bloquer).
+ *
+ * Hors coroutine (threads de service, mode threads), semopYield() et msgsndYield()
+ * attendent simplement comme semop() et msgsnd().
+ *
+ * @note une coroutine reste sur le thread qui l'a créée.
+ * Les réessais ne respectent pas l'ordre d'arrivée devant un sémaphore :
+ * l'équité lecteurs / rédacteur de QUEUE_SEM n'est assurée qu'entre threads.
+ ******************************************************************************/
+
+#ifndef COROUTINE_H
+#define COROUTINE_H
+
+#include "common.h"
+#include "scheduler.h"
+
+#include <sys/sem.h>
+
+#define COROUTINE_STACK_SIZE (32 * 1024) // pile d'une coroutine
+#define COROUTINES_PER_WORKER 4096 // nb max de coroutines d'un thread de traitement
+#define COROUTINE_POLL_US 50 // attente d'un thread dont aucune coroutine n'avance
+
+//prototypes de fonctions
+void initCoroutines(int nb_workers);
+void runCoroutineWorker(int worker, void (*handler)(Task *task));
+int semopYield(int semset_id, struct sembuf *operations, int nb_operations);
+int msgsndYield(int queue_id, const void *msg, size_t msg_size);
+void printCoroutineStats();
+
+#endif
@@ -0,0 +1,149 @@
+/*******************************************************************************
+ * @file dedup.c
+ * @brief Implémentation de la déduplication des requêtes de la question 1.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * cf dedup.h
+ * Etats d'une entrée : libre -> en cours (insertion par la boucle de réception)
+ * -> traitée (publication par le thread de traitement) -> réutilisable
+ * une fois la fenêtre écoulée. Une entrée en cours n'est jamais réutilisée,
+ * c'est donc toujours la même entrée que le thread de traitement retrouve.
+ *
+ * @note si toutes les entrées examinées sont occupées, la plus ancienne
+ * entrée traitée est réutilisée (la protection contre le rejeu est perdue
+ * pour elle seule) ; à défaut la requête est traitée sans déduplication.
+ ******************************************************************************/
+
+#include "dedup.h"
+
+#include <time.h>
+
+#define ENTRY_FREE 0
+#define ENTRY_PENDING 1
+#define ENTRY_DONE 2
+
+typedef struct {
+    unsigned long key; // (pid << 32) | request_id
+    time_t stamp; // date de réception de la requête
+    unsigned int state; // ENTRY_FREE, ENTRY_PENDING, ENTRY_DONE
+    Response response; // réponse publiée (état ENTRY_DONE)
+} DedupEntry;
+
+// variables du module
+static DedupEntry dedup_table[DEDUP_SIZE];
+
+/**
+ * @brief Clef d'une requête (0 : requête sans identifiant, non dédupliquée)
+ */
+static unsigned long requestKey(const Request *msg_req)
+{
+    if (msg_req->request_id == 0)
+    {
+        return 0;
+    }
+    return ((unsigned long)msg_req->pid << 32) | msg_req->request_id;
+}
+
+/**
+ * @brief Index de départ de la recherche d'une clef (mélange des bits)
+ */
+static unsigned int hashKey(unsigned long key)
+{
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdUL;
+    key ^= key >> 33;
+    return key & (DEDUP_SIZE - 1);
+}
+
+/**
+ * @brief Recherche une requête avant traitement (boucle de réception uniquement)
+ *
+ * Une requête nouvelle est enregistrée comme en cours de traitement.
+ * Les consultations ne modifient rien et ne sont pas dédupliquées.
+ *
+ * @param msg_req la requête reçue
+ * @param msg_resp reçoit la réponse déjà envoyée (résultat DEDUP_DONE)
+ * @return DEDUP_NEW, DEDUP_PENDING ou DEDUP_DONE
+ */
+DedupResult beginRequest(const Request *msg_req, Response *msg_resp)
+{
+    unsigned long key = requestKey(msg_req);
+    unsigned int start = hashKey(key);
+    time_t now = time(NULL);
+    DedupEntry *reusable = NULL; // première entrée libre ou périmée
+    DedupEntry *oldest = NULL; // plus ancienne entrée traitée
+
+    if (key == 0 || msg_req->request_type == REQUEST_CONSULT)
+    {
+        return DEDUP_NEW;
+    }
+
+    for (int probe = 0; probe < DEDUP_PROBES; probe++)
+    {
+        DedupEntry *entry = &dedup_table[(start + probe) & (DEDUP_SIZE - 1)];
+        unsigned int state = __atomic_load_n(&entry->state, __ATOMIC_ACQUIRE);
+
+        if (state != ENTRY_FREE && entry->key == key)
+        {
+            if (state == ENTRY_PENDING)
+            {
+                return DEDUP_PENDING;
+            }
+            *msg_resp = entry->response;
+            return DEDUP_DONE;
+        }
+        if (state == ENTRY_FREE
+            || (state == ENTRY_DONE && now - entry->stamp > DEDUP_WINDOW_SEC))
+        {
+            if (reusable == NULL)
+            {
+                reusable = entry;
+            }
+        }
+        else if (state == ENTRY_DONE && (oldest == NULL || entry->stamp < oldest->stamp))
+        {
+            oldest = entry;
+        }
+    }
+
+    DedupEntry *victim = (reusable != NULL) ? reusable : oldest;
+    if (victim != NULL)
+    {
+        victim->key = key;
+        victim->stamp = now;
+        __atomic_store_n(&victim->state, ENTRY_PENDING, __ATOMIC_RELEASE);
+    }
+    return DEDUP_NEW;
+}
+
+/**
+ * @brief Publie la réponse d'une requête traitée (threads de traitement)
+ *
+ * @param msg_req la requête traitée
+ * @param msg_resp la réponse envoyée au client
+ */
+void completeRequest(const Request *msg_req, const Response *msg_resp)
+{
+    unsigned long key = requestKey(msg_req);
+    unsigned int start = hashKey(key);
+
+    if (key == 0 || msg_req->request_type == REQUEST_CONSULT)
+    {
+        return;
+    }
+
+    for (int probe = 0; probe < DEDUP_PROBES; probe++)
+    {
+        DedupEntry *entry = &dedup_table[(start + probe) & (DEDUP_SIZE - 1)];
+
+        if (__atomic_load_n(&entry->state, __ATOMIC_ACQUIRE) == ENTRY_PENDING
+            && entry->key == key)
+        {
+            entry->response = *msg_resp;
+            __atomic_store_n(&entry->state, ENTRY_DONE, __ATOMIC_RELEASE);
+            return;
+        }
+    }
+}
@@ -0,0 +1,42 @@
+/*******************************************************************************
+ * @file dedup.h
+ * @brief Déduplication des requêtes rejouées du serveur de la question 1.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * Chaque requête porte un identifiant (request_id) choisi par le client,
+ * qui renvoie la même requête avec le même identifiant s'il n'a pas reçu
+ * de réponse à temps. Le serveur garde, pendant DEDUP_WINDOW_SEC secondes,
+ * la réponse de chaque requête (pid, request_id) modifiant les places :
+ * -> requête déjà traitée : la réponse en mémoire est renvoyée telle quelle
+ * -> requête en cours de traitement : le rejeu est ignoré (la réponse arrivera)
+ * -> sinon la requête est traitée normalement
+ * un client peut donc réémettre sans risque de double réservation.
+ *
+ * Table de taille fixe (DEDUP_SIZE entrées, adressage ouvert) sans verrou :
+ * seule la boucle de réception insère des entrées, les threads de traitement
+ * ne font que publier leur réponse (publication atomique de l'état).
+ ******************************************************************************/
+
+#ifndef DEDUP_H
+#define DEDUP_H
+
+#include "common.h"
+
+#define DEDUP_SIZE 4096 // nb d'entrées (puissance de 2)
+#define DEDUP_PROBES 8 // nb d'entrées examinées par recherche
+#define DEDUP_WINDOW_SEC 30 // durée de conservation des réponses
+
+// Résultat de la recherche d'une requête
+typedef enum {
+    DEDUP_NEW, // requête nouvelle, à traiter
+    DEDUP_PENDING, // rejeu d'une requête en cours de traitement
+    DEDUP_DONE // rejeu d'une requête traitée, réponse fournie
+} DedupResult;
+
+//prototypes de fonctions
+DedupResult beginRequest(const Request *msg_req, Response *msg_resp);
+void completeRequest(const Request *msg_req, const Response *msg_resp);
+
+#endif
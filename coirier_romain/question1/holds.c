@@ -0,0 +1,229 @@
+/*******************************************************************************
+ * @file holds.c
+ * @brief Implémentation des pré-réservations du serveur de la question 1.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * cf holds.h
+ * Les pré-réservations sont rangées dans une table indexée par ticket (cf ticket_table.h),
+ * le ticket étant renvoyé au client pour confirmer ou libérer.
+ *
+ * @note la table et la roue sont protégées par un mutex (holds_mutex),
+ * toujours pris avant les sections critiques du tableau des spectacles.
+ ******************************************************************************/
+
+#include "holds.h"
+#include "server.h"
+#include "bookings.h"
+#include "ticket_table.h"
+#include "timer_wheel.h"
+
+#include <pthread.h>
+#include <time.h>
+
+typedef struct {
+    TicketSlot slot; // en-tête de la table des tickets
+    TimerEntry timer; // échéance de la pré-réservation
+    int show_index;
+    signed char nb_seats;
+} Hold;
+
+// variables du module
+static TicketTable hold_table;
+static TimerWheel hold_wheel;
+static pthread_mutex_t holds_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * @brief Renvoie le tick courant (horloge monotone)
+ */
+static unsigned long currentTick()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec * 1000UL + now.tv_nsec / 1000000) / HOLD_TICK_MS;
+}
+
+/**
+ * @brief thread d'expiration des pré-réservations
+ *
+ * A chaque tick, avance la roue et rend les places des pré-réservations échues,
+ * cumulées par spectacle pour tout le lot.
+ *
+ * @param void* non utilisé
+ */
+static void* holdExpiry(void* arg)
+{
+    struct timespec tick = {0, HOLD_TICK_MS * 1000000L};
+    int nb_shows = getNbShows();
+    int *returned_seats;
+    TimerEntry expired;
+
+    if ((returned_seats = (int *)calloc(nb_shows, sizeof(int))) == NULL)
+    {
+        perror("Echec calloc.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    while (1)
+    {
+        nanosleep(&tick, NULL);
+        int nb_expired = 0;
+
+        initTimerList(&expired);
+        pthread_mutex_lock(&holds_mutex);
+        advanceTimerWheel(&hold_wheel, currentTick(), &expired);
+        while (!isTimerListEmpty(&expired))
+        {
+            Hold *hold = (Hold *)((char *)expired.next - offsetof(Hold, timer));
+            cancelTimer(&hold->timer);
+            returned_seats[hold->show_index] += hold->nb_seats;
+            freeTicket(&hold_table, hold);
+            nb_expired++;
+        }
+        pthread_mutex_unlock(&holds_mutex);
+
+        if (nb_expired == 0)
+        {
+            continue;
+        }
+        // restitution du lot, une section critique par spectacle concerné
+        // (les listes d'attente sont servies au passage)
+        for (int i = 0; i < nb_shows; i++)
+        {
+            if (returned_seats[i] > 0)
+            {
+                returnSeats(i, returned_seats[i]);
+            }
+        }
+        memset(returned_seats, 0, nb_shows * sizeof(int));
+        printf("Expiration de %d pre-reservations.\n", nb_expired);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Initialise la table des pré-réservations, la roue de temporisation
+ * et démarre le thread d'expiration
+ */
+void initHolds()
+{
+    pthread_t thread;
+
+    initTicketTable(&hold_table, sizeof(Hold), MAX_TICKETS);
+    initTimerWheel(&hold_wheel, currentTick());
+    if (pthread_create(&thread, NULL, holdExpiry, NULL) != 0)
+    {
+        perror("Echec creation du thread d expiration.\n");
+        exit(EXIT_FAILURE);
+    }
+    pthread_detach(thread);
+}
+
+/**
+ * @brief Bloque le nb de places demandé pour le spectacle passé en paramètre
+ *
+ * Les places sont retirées comme pour une réservation (cf takeSeats()),
+ * puis une pré-réservation est armée pour HOLD_TTL_SEC secondes.
+ *
+ * @param Message* nb de places > 0 : pré-réservation acceptée
+ *                              <= 0 : refusée (nb de places restantes en négatif)
+ * @return le ticket de la pré-réservation, 0 si refusée
+ */
+unsigned int holdSeats(Message *msg)
+{
+    unsigned int hold_id;
+    Hold *hold;
+
+    takeSeats(msg, 0);
+    if (msg->show_id[0] == '\0' || msg->nb_seats <= 0)
+    {
+        // spectacle inconnu ou pas assez de places
+        return 0;
+    }
+    int show_index = findShowIndex(msg->show_id);
+
+    pthread_mutex_lock(&holds_mutex);
+    if ((hold = (Hold *)allocTicket(&hold_table)) == NULL)
+    {
+        // table pleine : on rend les places
+        pthread_mutex_unlock(&holds_mutex);
+        returnSeats(show_index, msg->nb_seats);
+        msg->nb_seats = 0;
+        return 0;
+    }
+    hold->show_index = show_index;
+    hold->nb_seats = msg->nb_seats;
+    addTimer(&hold_wheel, &hold->timer, currentTick() + HOLD_TTL_SEC * 1000 / HOLD_TICK_MS);
+    hold_id = hold->slot.id;
+    pthread_mutex_unlock(&holds_mutex);
+
+    return hold_id;
+}
+
+/**
+ * @brief Confirme une pré-réservation : les places deviennent une réservation
+ *
+ * @param hold_id le ticket de la pré-réservation
+ * @param Message* reçoit le spectacle et le nb de places confirmées
+ *                 (tous les bits à 0 si le ticket est inconnu ou expiré)
+ * @return le numéro de la réservation créée (cf bookings.h), 0 si non confirmée
+ */
+unsigned int confirmHold(unsigned int hold_id, Message *msg)
+{
+    Hold *hold;
+    unsigned int booking_id;
+
+    pthread_mutex_lock(&holds_mutex);
+    if ((hold = (Hold *)lookupTicket(&hold_table, hold_id)) == NULL)
+    {
+        pthread_mutex_unlock(&holds_mutex);
+        memset(msg, 0, sizeof(Message));
+        return 0;
+    }
+    if ((booking_id = recordBooking(hold->show_index, hold->nb_seats)) == 0)
+    {
+        // table des réservations pleine : la pré-réservation reste en place
+        pthread_mutex_unlock(&holds_mutex);
+        memset(msg, 0, sizeof(Message));
+        return 0;
+    }
+    cancelTimer(&hold->timer);
+    memcpy(msg->show_id, SHOW_ID(hold->show_index), SHOW_ID_LEN);
+    msg->nb_seats = hold->nb_seats;
+    freeTicket(&hold_table, hold);
+    pthread_mutex_unlock(&holds_mutex);
+
+    return booking_id;
+}
+
+/**
+ * @brief Libère une pré-réservation : les places sont rendues au spectacle
+ *
+ * @param hold_id le ticket de la pré-réservation
+ * @param Message* reçoit le spectacle et le nb de places libérées
+ *                 (tous les bits à 0 si le ticket est inconnu ou expiré)
+ * @return true si la pré-réservation a été libérée
+ */
+bool releaseHold(unsigned int hold_id, Message *msg)
+{
+    Hold *hold;
+    int show_index;
+
+    pthread_mutex_lock(&holds_mutex);
+    if ((hold = (Hold *)lookupTicket(&hold_table, hold_id)) == NULL)
+    {
+        pthread_mutex_unlock(&holds_mutex);
+        memset(msg, 0, sizeof(Message));
+        return false;
+    }
+    cancelTimer(&hold->timer);
+    show_index = hold->show_index;
+    memcpy(msg->show_id, SHOW_ID(show_index), SHOW_ID_LEN);
+    msg->nb_seats = hold->nb_seats;
+    freeTicket(&hold_table, hold);
+    pthread_mutex_unlock(&holds_mutex);
+
+    returnSeats(show_index, msg->nb_seats);
+    return true;
+}
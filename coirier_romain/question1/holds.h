@@ -0,0 +1,29 @@
+/*******************************************************************************
+ * @file holds.h
+ * @brief Pré-réservations (places bloquées temporairement) du serveur de la question 1.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * Une pré-réservation retire immédiatement les places du tableau des spectacles,
+ * puis est soit confirmée (elle devient une réservation, cf bookings.h), soit libérée,
+ * soit expire au bout de HOLD_TTL_SEC secondes (les places sont rendues).
+ *
+ * Les expirations sont gérées par une roue de temporisation hiérarchique
+ * (cf timer_wheel.h) avancée par un thread dédié tous les HOLD_TICK_MS.
+ ******************************************************************************/
+
+#ifndef HOLDS_H
+#define HOLDS_H
+
+#include "common.h"
+
+#define HOLD_TICK_MS 10 // résolution des expirations
+
+//prototypes de fonctions
+void initHolds();
+unsigned int holdSeats(Message *msg);
+unsigned int confirmHold(unsigned int hold_id, Message *msg);
+bool releaseHold(unsigned int hold_id, Message *msg);
+
+#endif
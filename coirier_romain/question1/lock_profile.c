@@ -0,0 +1,166 @@
+/*******************************************************************************
+ * @file lock_profile.c
+ * @brief Implémentation du profil d'attente du verrou de la question 1.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * cf lock_profile.h
+ * Un jeu de compteurs atomiques par (opération, spectacle), communs à tous les threads.
+ ******************************************************************************/
+
+#include "lock_profile.h"
+#include "show_table.h"
+
+#include <time.h>
+
+// Compteurs d'une opération sur un spectacle
+typedef struct {
+    unsigned long nb_acquisitions;
+    unsigned long nb_contended; // acquisitions ayant dû attendre
+    unsigned long long wait_ns;
+    unsigned long long hold_ns;
+    unsigned long long max_wait_ns;
+} LockCounters;
+
+static const char *const SITE_NAMES[LOCK_NB_SITES] = {
+    "consultation", "prise", "restitution"
+};
+
+// variables du module
+static LockCounters *lock_counters; // nb_shows compteurs par opération
+static int nb_profiled_shows;
+
+/**
+ * @brief Alloue les compteurs (avant le lancement des threads)
+ *
+ * @param nb_shows le nb de spectacles du tableau
+ */
+void initLockProfile(int nb_shows)
+{
+    nb_profiled_shows = nb_shows;
+    if ((lock_counters = (LockCounters *)calloc(LOCK_NB_SITES * nb_shows, sizeof(LockCounters))) == NULL)
+    {
+        perror("Echec malloc.\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * @brief Instant courant en ns
+ */
+static long nowNs()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000000000L + now.tv_nsec;
+}
+
+/**
+ * @brief Demande du verrou (avant le prélude)
+ */
+void beginLockWait(LockTiming *timing)
+{
+    timing->request_ns = nowNs();
+}
+
+/**
+ * @brief Obtention du verrou (après le prélude)
+ *
+ * @param contended true si le prélude a dû attendre
+ */
+void lockAcquired(LockTiming *timing, bool contended)
+{
+    timing->acquired_ns = nowNs();
+    timing->contended = contended;
+}
+
+/**
+ * @brief Fin de la section critique (avant le postlude) : cumul de la mesure
+ *
+ * @param site l'opération en section critique
+ * @param show_index le spectacle concerné
+ */
+void lockReleased(const LockTiming *timing, LockSite site, int show_index)
+{
+    LockCounters *counters = &lock_counters[site * nb_profiled_shows + show_index];
+    unsigned long long wait_ns = timing->acquired_ns - timing->request_ns;
+
+    __atomic_add_fetch(&counters->nb_acquisitions, 1, __ATOMIC_RELAXED);
+    if (timing->contended)
+    {
+        __atomic_add_fetch(&counters->nb_contended, 1, __ATOMIC_RELAXED);
+    }
+    __atomic_add_fetch(&counters->wait_ns, wait_ns, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&counters->hold_ns, nowNs() - timing->acquired_ns, __ATOMIC_RELAXED);
+    unsigned long long max_wait_ns = __atomic_load_n(&counters->max_wait_ns, __ATOMIC_RELAXED);
+    while (wait_ns > max_wait_ns && !__atomic_compare_exchange_n(&counters->max_wait_ns, &max_wait_ns,
+        wait_ns, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+}
+
+/**
+ * @brief Ajoute les compteurs source à total (lecture atomique)
+ */
+static void addCounters(LockCounters *total, LockCounters *source)
+{
+    total->nb_acquisitions += __atomic_load_n(&source->nb_acquisitions, __ATOMIC_RELAXED);
+    total->nb_contended += __atomic_load_n(&source->nb_contended, __ATOMIC_RELAXED);
+    total->wait_ns += __atomic_load_n(&source->wait_ns, __ATOMIC_RELAXED);
+    total->hold_ns += __atomic_load_n(&source->hold_ns, __ATOMIC_RELAXED);
+    unsigned long long max_wait_ns = __atomic_load_n(&source->max_wait_ns, __ATOMIC_RELAXED);
+    if (max_wait_ns > total->max_wait_ns)
+    {
+        total->max_wait_ns = max_wait_ns;
+    }
+}
+
+/**
+ * @brief Affiche une ligne du profil
+ */
+static void printCounters(const char *site, const char *show_id, const LockCounters *counters)
+{
+    double nb = (double)counters->nb_acquisitions;
+
+    printf("  %-12s %-7s %10lu %9.1f%% %10.2f %10.2f %10.2f %9.2f\n", site, show_id,
+        counters->nb_acquisitions, 100.0 * counters->nb_contended / nb,
+        counters->wait_ns / nb / 1e3, counters->max_wait_ns / 1e3, counters->hold_ns / nb / 1e3,
+        counters->hold_ns > 0 ? (double)counters->wait_ns / counters->hold_ns : 0.0);
+}
+
+/**
+ * @brief Affiche le profil par opération, puis par spectacle
+ */
+void printLockProfile()
+{
+    if (lock_counters == NULL)
+    {
+        return;
+    }
+    printf("Verrou du tableau des spectacles (attente / tenue en us) :\n");
+    printf("  %-12s %-7s %10s %10s %10s %10s %10s %9s\n", "operation", "spect.", "acquis.",
+        "contendues", "attente", "att. max", "tenue", "att/tenue");
+    for (int site = 0; site < LOCK_NB_SITES; site++)
+    {
+        LockCounters total;
+        memset(&total, 0, sizeof(total));
+        for (int i = 0; i < nb_profiled_shows; i++)
+        {
+            addCounters(&total, &lock_counters[site * nb_profiled_shows + i]);
+        }
+        if (total.nb_acquisitions == 0)
+        {
+            continue;
+        }
+        printCounters(SITE_NAMES[site], "(tous)", &total);
+        for (int i = 0; i < nb_profiled_shows; i++)
+        {
+            LockCounters show_total;
+            memset(&show_total, 0, sizeof(show_total));
+            addCounters(&show_total, &lock_counters[site * nb_profiled_shows + i]);
+            if (show_total.nb_acquisitions > 0)
+            {
+                printCounters("", SHOW_ID(i), &show_total);
+            }
+        }
+    }
+}
@@ -0,0 +1,48 @@
+/*******************************************************************************
+ * @file lock_profile.h
+ * @brief Profil d'attente du verrou lecteurs / rédacteur de la question 1.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * Chaque section critique sur le tableau des spectacles est mesurée :
+ * -> beginLockWait() avant le prélude (enterReadSection(), enterWriteSection())
+ * -> lockAcquired() après le prélude, en indiquant s'il a fallu attendre
+ * -> lockReleased() juste avant le postlude
+ * Attente, tenue, attente max et nb d'acquisitions contendues (prélude bloqué
+ * par un autre thread) sont cumulés par opération et par spectacle,
+ * et affichés avec les statistiques (SIGUSR1, cf stats.h).
+ *
+ * @note le verrou est commun à tout le tableau : la ventilation par spectacle
+ * indique quels spectacles sont demandés pendant la contention, pas un verrou
+ * propre à chacun.
+ ******************************************************************************/
+
+#ifndef LOCK_PROFILE_H
+#define LOCK_PROFILE_H
+
+#include "common.h"
+
+// Opérations en section critique
+typedef enum {
+    LOCK_CONSULT, // lecture (getNbSeats())
+    LOCK_TAKE, // écriture : réservation, pré-réservation (takeSeats())
+    LOCK_RETURN, // écriture : annulation, libération (returnSeats())
+    LOCK_NB_SITES
+} LockSite;
+
+// Mesure d'une section critique
+typedef struct {
+    long request_ns; // demande du verrou
+    long acquired_ns; // obtention
+    bool contended; // prélude bloqué
+} LockTiming;
+
+//prototypes de fonctions
+void initLockProfile(int nb_shows);
+void beginLockWait(LockTiming *timing);
+void lockAcquired(LockTiming *timing, bool contended);
+void lockReleased(const LockTiming *timing, LockSite site, int show_index);
+void printLockProfile();
+
+#endif
@@ -0,0 +1,35 @@
+/*******************************************************************************
+ * @file pending_replies.h
+ * @brief Réponses différées de la boucle de réception de la question 1.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * La boucle de réception est la seule à retirer des requêtes de la file :
+ * elle ne doit jamais attendre de la place pour y déposer une réponse
+ * (refus STATUS_BUSY, rejeu d'une réponse déjà envoyée, cf dedup.h).
+ * sendReplyNoWait() envoie sans attente ; si la file est pleine, la réponse
+ * est mise de côté (dans l'ordre d'arrivée) au lieu d'être perdue, puis réémise
+ * par flushPendingReplies() avant chaque réception. Tant qu'il reste des
+ * réponses différées, la réception ne bloque pas (receiveAndFlush()) :
+ * chaque requête retirée libère de la place dans la file.
+ * Le client, qui attend sa réponse par un msgrcv bloquant, la reçoit donc toujours.
+ *
+ * Liste chaînée allouée à la demande, utilisée par la seule boucle de réception
+ * (sans verrou).
+ ******************************************************************************/
+
+#ifndef PENDING_REPLIES_H
+#define PENDING_REPLIES_H
+
+#include "common.h"
+
+#define PENDING_RETRY_US 500 // attente entre deux essais, réponses différées en attente
+
+//prototypes de fonctions
+void sendReplyNoWait(const Response *msg_resp);
+void flushPendingReplies();
+bool hasPendingReplies();
+int receiveAndFlush(Request *msg_req, long request_type);
+
+#endif
@@ -0,0 +1,276 @@
+/*******************************************************************************
+ * @file perf_counters.c
+ * @brief Implémentation des compteurs matériels de la question 1.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * cf perf_counters.h
+ * Les cumuls par opération sont des compteurs atomiques communs à tous les threads.
+ ******************************************************************************/
+
+#define _GNU_SOURCE // RUSAGE_THREAD
+
+#include "perf_counters.h"
+
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include <time.h>
+
+#define PERF_CONTEXT_SWITCHES 3 // index du compteur des changements de contexte
+
+// Compteurs du groupe, dans l'ordre de PerfSample.counters
+static const struct {
+    unsigned int type;
+    unsigned long long config;
+    const char *name;
+} PERF_EVENTS[PERF_NB_COUNTERS] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, "cycles"},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, "instructions"},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, "defauts de cache"},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES, "changements de contexte"}
+};
+
+static const char *const OPERATION_NAMES[PERF_NB_OPERATIONS] = {
+    "consultation", "reservation", "reception", "envoi"
+};
+
+// Groupe de compteurs d'un thread
+typedef struct {
+    bool opened; // ouverture tentée
+    int group_fd; // leader du groupe (-1 : aucun compteur)
+    int positions[PERF_NB_COUNTERS]; // rang dans la lecture du groupe (-1 : indisponible)
+} ThreadCounters;
+
+// Cumuls d'une opération
+typedef struct {
+    unsigned long nb_samples;
+    unsigned long long totals[PERF_NB_COUNTERS];
+    unsigned long long total_ns;
+    unsigned long long max_ns;
+} OperationTotals;
+
+// variables du module
+static bool perf_enabled = false;
+static __thread ThreadCounters thread_counters;
+static OperationTotals operation_totals[PERF_NB_OPERATIONS];
+static unsigned int available_counters; // bit i : compteur i ouvert par au moins un thread
+static int open_errno; // erreur du premier compteur refusé
+static bool kernel_excluded; // noyau exclu des mesures (perf_event_paranoid)
+
+/**
+ * @brief Active l'instrumentation (option -P)
+ *
+ * @param enabled false : startPerfSample() / stopPerfSample() ne font rien
+ */
+void initPerfCounters(bool enabled)
+{
+    perf_enabled = enabled;
+    if (enabled)
+    {
+        printf("Compteurs materiels des operations actives (affiches avec les statistiques).\n");
+    }
+}
+
+/**
+ * @brief Instant courant en ns
+ */
+static long nowNs()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000000000L + now.tv_nsec;
+}
+
+/**
+ * @brief Ouvre le groupe de compteurs du thread appelant
+ *
+ * Le premier compteur ouvert est le leader du groupe, les compteurs refusés
+ * par le noyau sont ignorés.
+ */
+static void openThreadCounters()
+{
+    struct perf_event_attr attr;
+    int nb_open = 0;
+
+    thread_counters.opened = true;
+    thread_counters.group_fd = -1;
+    for (int i = 0; i < PERF_NB_COUNTERS; i++)
+    {
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_EVENTS[i].type;
+        attr.config = PERF_EVENTS[i].config;
+        attr.read_format = PERF_FORMAT_GROUP;
+        attr.disabled = (thread_counters.group_fd == -1); // le leader démarre le groupe
+        attr.exclude_hv = 1;
+        int fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, thread_counters.group_fd, 0);
+        if (fd == -1 && (errno == EACCES || errno == EPERM))
+        {
+            // mesure du noyau (appels système compris) non autorisée : espace utilisateur seul
+            attr.exclude_kernel = 1;
+            fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, thread_counters.group_fd, 0);
+            if (fd != -1)
+            {
+                __atomic_store_n(&kernel_excluded, true, __ATOMIC_RELAXED);
+            }
+        }
+        if (fd == -1)
+        {
+            int expected = 0;
+            thread_counters.positions[i] = -1;
+            __atomic_compare_exchange_n(&open_errno, &expected, errno, false,
+                __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+            continue;
+        }
+        if (thread_counters.group_fd == -1)
+        {
+            thread_counters.group_fd = fd;
+        }
+        thread_counters.positions[i] = nb_open++;
+        __atomic_or_fetch(&available_counters, 1U << i, __ATOMIC_RELAXED);
+    }
+    if (thread_counters.group_fd != -1)
+    {
+        ioctl(thread_counters.group_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+}
+
+/**
+ * @brief Lit les compteurs du thread appelant (0 pour un compteur indisponible)
+ */
+static void readThreadCounters(unsigned long long counters[PERF_NB_COUNTERS])
+{
+    struct {
+        unsigned long long nb;
+        unsigned long long values[PERF_NB_COUNTERS];
+    } group;
+
+    memset(&group, 0, sizeof(group));
+    if (thread_counters.group_fd != -1
+        && read(thread_counters.group_fd, &group, sizeof(group)) == -1)
+    {
+        memset(&group, 0, sizeof(group));
+    }
+    for (int i = 0; i < PERF_NB_COUNTERS; i++)
+    {
+        counters[i] = (thread_counters.positions[i] >= 0) ? group.values[thread_counters.positions[i]] : 0;
+    }
+    if (thread_counters.positions[PERF_CONTEXT_SWITCHES] < 0)
+    {
+        // repli : changements de contexte volontaires et forcés du thread
+        struct rusage usage;
+        if (getrusage(RUSAGE_THREAD, &usage) == 0)
+        {
+            counters[PERF_CONTEXT_SWITCHES] = usage.ru_nvcsw + usage.ru_nivcsw;
+        }
+    }
+}
+
+/**
+ * @brief Début de la mesure d'une opération
+ *
+ * @param sample reçoit les valeurs de départ
+ */
+void startPerfSample(PerfSample *sample)
+{
+    sample->active = perf_enabled;
+    if (!perf_enabled)
+    {
+        return;
+    }
+    if (!thread_counters.opened)
+    {
+        openThreadCounters();
+    }
+    readThreadCounters(sample->counters);
+    sample->start_ns = nowNs();
+}
+
+/**
+ * @brief Fin de la mesure d'une opération : écarts cumulés
+ *
+ * @param sample la mesure commencée par startPerfSample()
+ * @param operation l'opération mesurée
+ */
+void stopPerfSample(PerfSample *sample, PerfOperation operation)
+{
+    unsigned long long counters[PERF_NB_COUNTERS];
+    OperationTotals *totals = &operation_totals[operation];
+
+    if (!sample->active)
+    {
+        return;
+    }
+    unsigned long long elapsed_ns = nowNs() - sample->start_ns;
+    readThreadCounters(counters);
+    for (int i = 0; i < PERF_NB_COUNTERS; i++)
+    {
+        __atomic_add_fetch(&totals->totals[i], counters[i] - sample->counters[i], __ATOMIC_RELAXED);
+    }
+    __atomic_add_fetch(&totals->total_ns, elapsed_ns, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&totals->nb_samples, 1, __ATOMIC_RELAXED);
+    unsigned long long max_ns = __atomic_load_n(&totals->max_ns, __ATOMIC_RELAXED);
+    while (elapsed_ns > max_ns && !__atomic_compare_exchange_n(&totals->max_ns, &max_ns, elapsed_ns,
+        true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+}
+
+/**
+ * @brief Affiche les moyennes par opération (compteurs indisponibles : n/d)
+ */
+void printPerfStats()
+{
+    unsigned int available = __atomic_load_n(&available_counters, __ATOMIC_RELAXED);
+    int error = __atomic_load_n(&open_errno, __ATOMIC_RELAXED);
+
+    if (!perf_enabled)
+    {
+        return;
+    }
+    printf("Compteurs par operation (moyennes) :\n");
+    if (error != 0)
+    {
+        printf("  compteurs refuses par le noyau (%s) :", strerror(error));
+        for (int i = 0; i < PERF_NB_COUNTERS; i++)
+        {
+            if ((available & (1U << i)) == 0)
+            {
+                printf(" %s", PERF_EVENTS[i].name);
+            }
+        }
+        printf("\n");
+    }
+    if (__atomic_load_n(&kernel_excluded, __ATOMIC_RELAXED))
+    {
+        printf("  (espace utilisateur seulement : appels systeme non comptes)\n");
+    }
+    printf("  %-13s %10s %10s %10s %12s %10s %12s %12s\n", "operation", "nb", "ns", "ns max",
+        "cycles", "instr.", "def. cache", "chgt. ctx");
+    for (int op = 0; op < PERF_NB_OPERATIONS; op++)
+    {
+        OperationTotals *totals = &operation_totals[op];
+        unsigned long nb_samples = __atomic_load_n(&totals->nb_samples, __ATOMIC_RELAXED);
+
+        if (nb_samples == 0)
+        {
+            continue;
+        }
+        printf("  %-13s %10lu %10.0f %10llu", OPERATION_NAMES[op], nb_samples,
+            (double)__atomic_load_n(&totals->total_ns, __ATOMIC_RELAXED) / nb_samples,
+            __atomic_load_n(&totals->max_ns, __ATOMIC_RELAXED));
+        for (int i = 0; i < PERF_NB_COUNTERS; i++)
+        {
+            int width = (i == 1) ? 10 : 12;
+            if ((available & (1U << i)) == 0 && i != PERF_CONTEXT_SWITCHES)
+            {
+                printf(" %*s", width, "n/d");
+                continue;
+            }
+            printf(" %*.1f", width,
+                (double)__atomic_load_n(&totals->totals[i], __ATOMIC_RELAXED) / nb_samples);
+        }
+        printf("\n");
+    }
+}
@@ -0,0 +1,53 @@
+/*******************************************************************************
+ * @file perf_counters.h
+ * @brief Compteurs matériels des opérations du serveur de la question 1 (option -P).
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * Chaque opération instrumentée (consultation, réservation, réception et envoi
+ * des messages) est encadrée par startPerfSample() / stopPerfSample() :
+ * cycles, instructions, défauts de cache et changements de contexte du thread
+ * (perf_event_open) ainsi que la durée écoulée sont cumulés par opération
+ * et affichés avec les statistiques (SIGUSR1, cf stats.h).
+ *
+ * Les compteurs sont ouverts par chaque thread à sa première mesure, en un
+ * groupe lu d'un seul read(). Un compteur que le noyau n'expose pas (machine
+ * virtuelle, perf_event_paranoid) est affiché "n/d" ; les changements de
+ * contexte sont alors relevés par getrusage().
+ *
+ * @note les compteurs sont ceux du thread : en mode coroutines (-C), une mesure
+ * suspendue inclut le travail des coroutines reprises entre-temps ;
+ * la réception inclut l'attente d'une requête.
+ ******************************************************************************/
+
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include "common.h"
+
+#define PERF_NB_COUNTERS 4 // cycles, instructions, défauts de cache, changements de contexte
+
+// Opérations instrumentées
+typedef enum {
+    PERF_CONSULT, // getNbSeats()
+    PERF_BOOK, // bookSeats()
+    PERF_RECEIVE, // msgrcv() d'une requête
+    PERF_SEND, // msgsnd() d'une réponse
+    PERF_NB_OPERATIONS
+} PerfOperation;
+
+// Mesure en cours
+typedef struct {
+    bool active; // false : instrumentation désactivée
+    unsigned long long counters[PERF_NB_COUNTERS];
+    long start_ns;
+} PerfSample;
+
+//prototypes de fonctions
+void initPerfCounters(bool enabled);
+void startPerfSample(PerfSample *sample);
+void stopPerfSample(PerfSample *sample, PerfOperation operation);
+void printPerfStats();
+
+#endif
@@ -0,0 +1,154 @@
+/*******************************************************************************
+ * @file rate_limit.c
+ * @brief Implémentation de la limitation de débit par client de la question 1.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * cf rate_limit.h
+ * Les jetons sont comptés en millièmes (entier) pour regarnir au fil
+ * des millisecondes écoulées sans arrondi cumulé.
+ ******************************************************************************/
+
+#include "rate_limit.h"
+
+#include <time.h>
+
+#define TOKEN_SCALE 1000 // millièmes de jeton
+#define FULL_BUCKET (RATE_LIMIT_BURST * TOKEN_SCALE)
+
+typedef struct {
+    pid_t pid; // 0 : seau libre
+    unsigned int tokens; // jetons restants (millièmes)
+    unsigned int stamp; // date du dernier regarnissage (ms)
+} Bucket;
+
+// variables du module
+static Bucket buckets[RATE_LIMIT_SIZE];
+static int refill_rate = DEFAULT_RATE_LIMIT; // jetons par seconde (0 : pas de limite)
+static unsigned long nb_limited;
+static unsigned long nb_evicted;
+
+/**
+ * @brief Date courante en ms (horloge monotone, tronquée à 32 bits)
+ */
+static unsigned int currentMs()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (unsigned int)(now.tv_sec * 1000UL + now.tv_nsec / 1000000);
+}
+
+/**
+ * @brief Regarnit un seau des jetons gagnés depuis son dernier regarnissage
+ */
+static void refillBucket(Bucket *bucket, unsigned int now)
+{
+    unsigned long elapsed = now - bucket->stamp; // correct au passage à 0 de l'horloge
+    unsigned long tokens = bucket->tokens + elapsed * refill_rate; // ms * jetons/s = millièmes
+
+    bucket->tokens = (tokens > FULL_BUCKET) ? FULL_BUCKET : (unsigned int)tokens;
+    bucket->stamp = now;
+}
+
+/**
+ * @brief Fixe le débit autorisé de chaque client
+ *
+ * @param rate nb de requêtes par seconde et par client (0 : pas de limite)
+ */
+void initRateLimit(int rate)
+{
+    refill_rate = rate;
+    if (refill_rate > 0)
+    {
+        printf("Limitation de debit : %d requetes par seconde et par client (rafales de %d).\n",
+            refill_rate, RATE_LIMIT_BURST);
+    }
+}
+
+/**
+ * @brief Consomme un jeton du seau d'un client (boucle de réception uniquement)
+ *
+ * @param pid le client
+ * @param retry_after_ms reçoit, en cas de refus, le délai avant le prochain jeton
+ * @return bool : true si la requête peut être traitée
+ */
+bool allowRequest(pid_t pid, int *retry_after_ms)
+{
+    unsigned int start = ((unsigned int)pid * 2654435761U) & (RATE_LIMIT_SIZE - 1);
+    unsigned int now = currentMs();
+    Bucket *bucket = NULL;
+    Bucket *reusable = NULL; // premier seau libre ou plein
+    Bucket *oldest = NULL; // seau le plus anciennement regarni
+
+    if (refill_rate <= 0)
+    {
+        return true;
+    }
+
+    for (int probe = 0; probe < RATE_LIMIT_PROBES && bucket == NULL; probe++)
+    {
+        Bucket *entry = &buckets[(start + probe) & (RATE_LIMIT_SIZE - 1)];
+
+        if (entry->pid == pid)
+        {
+            bucket = entry;
+            refillBucket(bucket, now);
+        }
+        else if (entry->pid == 0)
+        {
+            if (reusable == NULL)
+            {
+                reusable = entry;
+            }
+        }
+        else
+        {
+            refillBucket(entry, now);
+            if (entry->tokens == FULL_BUCKET && reusable == NULL)
+            {
+                reusable = entry;
+            }
+            if (oldest == NULL || (int)(entry->stamp - oldest->stamp) < 0)
+            {
+                oldest = entry;
+            }
+        }
+    }
+    if (bucket == NULL)
+    {
+        // nouveau client : seau plein
+        if ((bucket = reusable) == NULL)
+        {
+            bucket = oldest;
+            __atomic_add_fetch(&nb_evicted, 1, __ATOMIC_RELAXED);
+        }
+        bucket->pid = pid;
+        bucket->tokens = FULL_BUCKET;
+        bucket->stamp = now;
+    }
+
+    if (bucket->tokens < TOKEN_SCALE)
+    {
+        __atomic_add_fetch(&nb_limited, 1, __ATOMIC_RELAXED);
+        *retry_after_ms = (TOKEN_SCALE - bucket->tokens + refill_rate - 1) / refill_rate;
+        return false;
+    }
+    bucket->tokens -= TOKEN_SCALE;
+    return true;
+}
+
+/**
+ * @brief Affiche les compteurs de la limitation de débit
+ */
+void printRateLimitStats()
+{
+    if (refill_rate <= 0)
+    {
+        printf("Limitation de debit : desactivee.\n");
+        return;
+    }
+    printf("Limitation de debit : %lu requetes refusees, %lu seaux repris (%d req/s par client).\n",
+        __atomic_load_n(&nb_limited, __ATOMIC_RELAXED),
+        __atomic_load_n(&nb_evicted, __ATOMIC_RELAXED), refill_rate);
+}
@@ -0,0 +1,41 @@
+/*******************************************************************************
+ * @file rate_limit.h
+ * @brief Limitation du débit de chaque client du serveur de la question 1.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * Chaque client (pid de la requête) dispose d'un seau de jetons :
+ * RATE_LIMIT_BURST jetons au plus, regarnis de rate jetons par seconde
+ * (option -r du serveur, 0 : pas de limite). Une requête consomme un jeton ;
+ * sans jeton, elle est refusée avant le contrôle d'admission par une réponse
+ * STATUS_BUSY dont le délai est le temps de regarnir un jeton.
+ * Un client trop bavard ne consomme donc ni threads ni place dans les files
+ * de l'ordonnanceur au détriment des autres.
+ *
+ * Table compacte de taille fixe (RATE_LIMIT_SIZE seaux, adressage ouvert),
+ * sans verrou : seule la boucle de réception la lit et la modifie.
+ * Les seaux sont regarnis paresseusement, au passage de la requête suivante
+ * du client, d'après la date du dernier regarnissage.
+ *
+ * @note un seau plein est de nouveau libre (son client n'a rien consommé
+ * depuis assez longtemps) ; si toutes les entrées examinées sont occupées,
+ * le seau le plus anciennement utilisé est repris.
+ ******************************************************************************/
+
+#ifndef RATE_LIMIT_H
+#define RATE_LIMIT_H
+
+#include "common.h"
+
+#define DEFAULT_RATE_LIMIT 200 // requêtes par seconde et par client
+#define RATE_LIMIT_BURST 50 // jetons d'un seau plein (rafale autorisée)
+#define RATE_LIMIT_SIZE 4096 // nb de seaux (puissance de 2)
+#define RATE_LIMIT_PROBES 8 // nb de seaux examinés par recherche
+
+//prototypes de fonctions
+void initRateLimit(int rate);
+bool allowRequest(pid_t pid, int *retry_after_ms);
+void printRateLimitStats();
+
+#endif
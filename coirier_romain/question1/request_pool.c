@@ -0,0 +1,105 @@
+/*******************************************************************************
+ * @file request_pool.c
+ * @brief Implémentation des emplacements de requêtes de la question 1.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * cf request_pool.h
+ * Le champ next d'un emplacement libre chaîne la pile des emplacements libres.
+ ******************************************************************************/
+
+#include "request_pool.h"
+
+#include <sched.h>
+
+// variables du module
+static Task *slots; // le tableau des emplacements
+static int nb_slots;
+static Task *free_slots; // sommet de la pile des emplacements libres
+static unsigned long nb_in_use;
+static unsigned long peak_in_use;
+static unsigned long nb_waits; // prises sur pile vide (ne devrait pas arriver)
+
+/**
+ * @brief Alloue le tableau des emplacements, tous libres
+ *
+ * @param nb le nb d'emplacements
+ */
+void initRequestPool(int nb)
+{
+    nb_slots = nb;
+    if ((slots = (Task *)calloc(nb_slots, sizeof(Task))) == NULL)
+    {
+        perror("Echec calloc.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < nb_slots - 1; i++)
+    {
+        slots[i].next = &slots[i + 1];
+    }
+    slots[nb_slots - 1].next = NULL;
+    free_slots = &slots[0];
+}
+
+/**
+ * @brief Prend un emplacement libre (boucle de réception uniquement)
+ *
+ * @return Task* l'emplacement, à remplir par msgrcv puis à confier à submitTask()
+ */
+Task *acquireTask()
+{
+    Task *task = __atomic_load_n(&free_slots, __ATOMIC_ACQUIRE);
+
+    while (1)
+    {
+        if (task == NULL)
+        {
+            // tous les emplacements sont en cours : on attend qu'un thread en rende un
+            __atomic_add_fetch(&nb_waits, 1, __ATOMIC_RELAXED);
+            sched_yield();
+            task = __atomic_load_n(&free_slots, __ATOMIC_ACQUIRE);
+        }
+        else if (__atomic_compare_exchange_n(&free_slots, &task, task->next, false,
+            __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE))
+        {
+            break;
+        }
+    }
+    task->next = NULL;
+
+    unsigned long in_use = __atomic_add_fetch(&nb_in_use, 1, __ATOMIC_RELAXED);
+    if (in_use > peak_in_use)
+    {
+        __atomic_store_n(&peak_in_use, in_use, __ATOMIC_RELAXED);
+    }
+    return task;
+}
+
+/**
+ * @brief Rend un emplacement, une fois la réponse envoyée (tout thread)
+ *
+ * @param task l'emplacement, qui ne doit plus être utilisé
+ */
+void recycleTask(Task *task)
+{
+    Task *head = __atomic_load_n(&free_slots, __ATOMIC_RELAXED);
+
+    do
+    {
+        task->next = head;
+    } while (!__atomic_compare_exchange_n(&free_slots, &head, task, false,
+        __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+    __atomic_sub_fetch(&nb_in_use, 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Affiche l'occupation des emplacements
+ */
+void printRequestPoolStats()
+{
+    printf("Emplacements de requetes : %lu utilises (pic %lu) sur %d, %lu attentes.\n",
+        __atomic_load_n(&nb_in_use, __ATOMIC_RELAXED),
+        __atomic_load_n(&peak_in_use, __ATOMIC_RELAXED), nb_slots,
+        __atomic_load_n(&nb_waits, __ATOMIC_RELAXED));
+}
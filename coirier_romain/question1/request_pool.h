@@ -0,0 +1,36 @@
+/*******************************************************************************
+ * @file request_pool.h
+ * @brief Emplacements de requêtes pré-alloués du serveur de la question 1.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * Les requêtes ne sont plus copiées dans une tâche allouée par malloc :
+ * un tableau fixe d'emplacements (Task) est alloué au démarrage et
+ * la boucle de réception lit chaque requête (msgrcv) directement dans
+ * un emplacement libre. L'emplacement est ensuite confié par pointeur à
+ * l'ordonnanceur puis au thread de traitement, qui le rend une fois la
+ * réponse envoyée : ni malloc, ni copie par requête, et aucun emplacement
+ * n'est réécrit tant qu'un thread le traite.
+ *
+ * Taille du tableau : nb max de requêtes en cours (cf admission.h)
+ * + une par thread de traitement (requête répondue, emplacement pas encore rendu)
+ * + celle en cours de réception.
+ *
+ * Les emplacements libres forment une pile sans verrou : seule la boucle
+ * de réception en prend (pas de problème ABA), tous les threads en rendent.
+ ******************************************************************************/
+
+#ifndef REQUEST_POOL_H
+#define REQUEST_POOL_H
+
+#include "common.h"
+#include "scheduler.h"
+
+//prototypes de fonctions
+void initRequestPool(int nb_slots);
+Task *acquireTask();
+void recycleTask(Task *task);
+void printRequestPoolStats();
+
+#endif
@@ -0,0 +1,419 @@
+/*******************************************************************************
+ * @file scheduler.c
+ * @brief Implémentation de l'ordonnancement équitable de la question 1.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * cf scheduler.h
+ * Chaque classe tient l'anneau de ses files client non vides : la file servie
+ * passe en fin d'anneau si elle a encore des requêtes, sinon elle est rendue
+ * au stock de la classe. Une classe qui redevient non vide reprend au temps
+ * virtuel courant (pas de crédit accumulé pendant son inactivité).
+ *
+ * Chaque ordonnanceur (un seul en mode central, un par thread en vol de travail)
+ * est protégé par son propre mutex. Les threads sans travail s'endorment sur
+ * une variable condition commune : nb_pending (requêtes rangées non prises)
+ * et nb_idle (threads endormis) sont relus en ordre séquentiel de part et
+ * d'autre, un thread ne s'endort donc jamais avec une requête en attente.
+ ******************************************************************************/
+
+#include "scheduler.h"
+#include "coroutine.h"
+
+#include <pthread.h>
+
+typedef struct Flow {
+    pid_t pid;
+    Task *head; // prochaine requête du client
+    Task *tail;
+    struct Flow *next_active; // suivante dans l'anneau des files non vides
+    struct Flow *next_hash; // suivante dans la table de recherche (ou le stock)
+} Flow;
+
+typedef struct {
+    Flow flows[SCHED_MAX_FLOWS];
+    Flow *free_flows; // stock des files inutilisées
+    Flow *hash[SCHED_HASH_SIZE]; // recherche de la file d'un client
+    Flow shared_flow; // file commune quand le stock est épuisé
+    Flow *active_head; // prochaine file servie
+    Flow *active_tail;
+    unsigned long vtime; // temps virtuel de la classe
+    unsigned int weight;
+    unsigned long nb_queued;
+    unsigned long nb_served;
+} ClassQueue;
+
+// Ordonnanceur : files pondérées par classe, files client dans chaque classe
+typedef struct {
+    pthread_mutex_t mutex;
+    ClassQueue classes[NB_CLASSES];
+    unsigned long current_vtime; // temps virtuel de la dernière requête servie
+    unsigned long nb_queued; // toutes classes confondues
+    unsigned long nb_stolen; // requêtes prises par un autre thread
+} Scheduler;
+
+// variables du module
+static Scheduler *schedulers; // un seul en mode central, un par thread sinon
+static int nb_schedulers;
+static void (*task_handler)(Task *task);
+static int nb_workers;
+static bool work_stealing;
+static bool coroutine_mode;
+static unsigned long nb_pending; // requêtes rangées, pas encore prises
+static int nb_idle; // threads endormis
+static pthread_mutex_t idle_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t idle_cond = PTHREAD_COND_INITIALIZER;
+
+/**
+ * @brief Classe d'une requête
+ */
+static RequestClass classOf(const Request *msg_req)
+{
+    return (msg_req->request_type == REQUEST_CONSULT) ? CLASS_CONSULT : CLASS_RESERVE;
+}
+
+/**
+ * @brief Index de la table de recherche d'un client (mélange des bits)
+ */
+static unsigned int hashPid(pid_t pid)
+{
+    return ((unsigned int)pid * 2654435761U) >> 8;
+}
+
+/**
+ * @brief Renvoie la file d'un client dans une classe, créée au besoin
+ *
+ * @note à appeler sous le mutex de l'ordonnanceur
+ */
+static Flow *getFlow(ClassQueue *queue, pid_t pid)
+{
+    unsigned int bucket = hashPid(pid) & (SCHED_HASH_SIZE - 1);
+    Flow *flow;
+
+    for (flow = queue->hash[bucket]; flow != NULL; flow = flow->next_hash)
+    {
+        if (flow->pid == pid)
+        {
+            return flow;
+        }
+    }
+    if ((flow = queue->free_flows) == NULL)
+    {
+        return &queue->shared_flow;
+    }
+    queue->free_flows = flow->next_hash;
+    flow->pid = pid;
+    flow->head = flow->tail = NULL;
+    flow->next_hash = queue->hash[bucket];
+    queue->hash[bucket] = flow;
+    return flow;
+}
+
+/**
+ * @brief Rend au stock la file vide d'un client
+ *
+ * @note à appeler sous le mutex de l'ordonnanceur
+ */
+static void releaseFlow(ClassQueue *queue, Flow *flow)
+{
+    unsigned int bucket = hashPid(flow->pid) & (SCHED_HASH_SIZE - 1);
+    Flow **link = &queue->hash[bucket];
+
+    if (flow == &queue->shared_flow)
+    {
+        return;
+    }
+    while (*link != flow)
+    {
+        link = &(*link)->next_hash;
+    }
+    *link = flow->next_hash;
+    flow->next_hash = queue->free_flows;
+    queue->free_flows = flow;
+}
+
+/**
+ * @brief Range une requête dans un ordonnanceur
+ */
+static void enqueueTask(Scheduler *scheduler, Task *task)
+{
+    ClassQueue *queue = &scheduler->classes[classOf(&task->msg_req)];
+
+    task->next = NULL;
+    pthread_mutex_lock(&scheduler->mutex);
+    if (queue->nb_queued == 0 && queue->vtime < scheduler->current_vtime)
+    {
+        // pas de crédit accumulé pendant l'inactivité de la classe
+        queue->vtime = scheduler->current_vtime;
+    }
+    Flow *flow = getFlow(queue, task->msg_req.pid);
+    if (flow->head == NULL)
+    {
+        // la file devient active : en fin d'anneau
+        flow->head = task;
+        flow->next_active = NULL;
+        if (queue->active_head == NULL)
+        {
+            queue->active_head = flow;
+        }
+        else
+        {
+            queue->active_tail->next_active = flow;
+        }
+        queue->active_tail = flow;
+    }
+    else
+    {
+        flow->tail->next = task;
+    }
+    flow->tail = task;
+    queue->nb_queued++;
+    __atomic_add_fetch(&scheduler->nb_queued, 1, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&scheduler->mutex);
+}
+
+/**
+ * @brief Retire, sans attendre, la prochaine requête d'un ordonnanceur
+ *
+ * Classe non vide de plus petit temps virtuel (à égalité, les réservations),
+ * puis file client en tête de son anneau.
+ *
+ * @return la requête, NULL si l'ordonnanceur est vide
+ */
+static Task *dequeueTask(Scheduler *scheduler)
+{
+    ClassQueue *queue = NULL;
+
+    // lecture sans verrou : un ordonnanceur vide est ignoré sans le bloquer
+    if (__atomic_load_n(&scheduler->nb_queued, __ATOMIC_RELAXED) == 0)
+    {
+        return NULL;
+    }
+    pthread_mutex_lock(&scheduler->mutex);
+    for (int i = 0; i < NB_CLASSES; i++)
+    {
+        ClassQueue *candidate = &scheduler->classes[i];
+        if (candidate->nb_queued > 0 && (queue == NULL || candidate->vtime < queue->vtime))
+        {
+            queue = candidate;
+        }
+    }
+    if (queue == NULL)
+    {
+        pthread_mutex_unlock(&scheduler->mutex);
+        return NULL;
+    }
+    scheduler->current_vtime = queue->vtime;
+    queue->vtime += SCHED_VTIME_UNIT / queue->weight;
+
+    Flow *flow = queue->active_head;
+    Task *task = flow->head;
+    flow->head = task->next;
+    queue->active_head = flow->next_active;
+    if (flow->head != NULL)
+    {
+        // encore des requêtes : la file passe en fin d'anneau
+        flow->next_active = NULL;
+        if (queue->active_head == NULL)
+        {
+            queue->active_head = flow;
+        }
+        else
+        {
+            queue->active_tail->next_active = flow;
+        }
+        queue->active_tail = flow;
+    }
+    else
+    {
+        releaseFlow(queue, flow);
+    }
+    queue->nb_queued--;
+    queue->nb_served++;
+    __atomic_sub_fetch(&scheduler->nb_queued, 1, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&scheduler->mutex);
+    return task;
+}
+
+/**
+ * @brief Range une requête admise (boucle de réception)
+ *
+ * En vol de travail, la requête va à l'ordonnanceur du thread associé à son
+ * client : les requêtes d'un même client restent sur le même thread.
+ * Un thread endormi est réveillé, il volera la requête si son propriétaire est occupé.
+ *
+ * @param task la requête (rendue au gestionnaire des threads de traitement)
+ */
+void submitTask(Task *task)
+{
+    enqueueTask(&schedulers[hashPid(task->msg_req.pid) % nb_schedulers], task);
+
+    __atomic_add_fetch(&nb_pending, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&nb_idle, __ATOMIC_SEQ_CST) > 0)
+    {
+        pthread_mutex_lock(&idle_mutex);
+        pthread_cond_signal(&idle_cond);
+        pthread_mutex_unlock(&idle_mutex);
+    }
+}
+
+/**
+ * @brief Prochaine requête d'un thread, sans attendre : la sienne, ou volée à un autre thread
+ *
+ * @param worker l'index du thread
+ * @return la requête, NULL si aucun ordonnanceur n'en a
+ */
+Task *takeTask(int worker)
+{
+    int own = worker % nb_schedulers;
+    Task *task;
+
+    for (int i = 0; i < nb_schedulers; i++)
+    {
+        Scheduler *scheduler = &schedulers[(own + i) % nb_schedulers];
+        if ((task = dequeueTask(scheduler)) != NULL)
+        {
+            if (i > 0)
+            {
+                __atomic_add_fetch(&scheduler->nb_stolen, 1, __ATOMIC_RELAXED);
+            }
+            __atomic_sub_fetch(&nb_pending, 1, __ATOMIC_SEQ_CST);
+            return task;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Endort le thread appelant jusqu'à ce qu'une requête soit rangée
+ *
+ * Retour immédiat si une requête est déjà en attente.
+ */
+void waitForTask()
+{
+    pthread_mutex_lock(&idle_mutex);
+    __atomic_add_fetch(&nb_idle, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&nb_pending, __ATOMIC_SEQ_CST) == 0)
+    {
+        pthread_cond_wait(&idle_cond, &idle_mutex);
+    }
+    __atomic_sub_fetch(&nb_idle, 1, __ATOMIC_SEQ_CST);
+    pthread_mutex_unlock(&idle_mutex);
+}
+
+/**
+ * @brief Corps d'un thread de traitement
+ *
+ * @param void* l'index du thread
+ */
+static void *workerLoop(void *arg)
+{
+    int worker = (int)(long)arg;
+    Task *task;
+
+    if (coroutine_mode)
+    {
+        // une coroutine par requête (cf coroutine.h)
+        runCoroutineWorker(worker, task_handler);
+    }
+    while (1)
+    {
+        if ((task = takeTask(worker)) != NULL)
+        {
+            task_handler(task);
+            continue;
+        }
+        // rien à prendre : on s'endort, sauf si une requête vient d'être rangée
+        waitForTask();
+    }
+    return NULL;
+}
+
+/**
+ * @brief Initialise les ordonnanceurs et lance les threads de traitement
+ *
+ * @param nb le nb de threads de traitement
+ * @param stealing true : un ordonnanceur par thread avec vol de travail,
+ *                 false : un ordonnanceur central
+ * @param coroutines true : requêtes traitées en coroutines (cf coroutine.h)
+ * @param handler la fonction de traitement d'une requête (libère la requête)
+ */
+void initScheduler(int nb, bool stealing, bool coroutines, void (*handler)(Task *task))
+{
+    pthread_t thread;
+
+    task_handler = handler;
+    nb_workers = nb;
+    work_stealing = stealing;
+    coroutine_mode = coroutines;
+    nb_schedulers = work_stealing ? nb_workers : 1;
+    if ((schedulers = (Scheduler *)calloc(nb_schedulers, sizeof(Scheduler))) == NULL)
+    {
+        perror("Echec calloc.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int s = 0; s < nb_schedulers; s++)
+    {
+        pthread_mutex_init(&schedulers[s].mutex, NULL);
+        schedulers[s].classes[CLASS_RESERVE].weight = SCHED_WEIGHT_RESERVE;
+        schedulers[s].classes[CLASS_CONSULT].weight = SCHED_WEIGHT_CONSULT;
+        for (int i = 0; i < NB_CLASSES; i++)
+        {
+            ClassQueue *queue = &schedulers[s].classes[i];
+            for (int j = 0; j < SCHED_MAX_FLOWS; j++)
+            {
+                queue->flows[j].next_hash = (j + 1 < SCHED_MAX_FLOWS) ? &queue->flows[j + 1] : NULL;
+            }
+            queue->free_flows = &queue->flows[0];
+        }
+    }
+
+    if (coroutine_mode)
+    {
+        initCoroutines(nb_workers);
+    }
+
+    for (int i = 0; i < nb_workers; i++)
+    {
+        if (pthread_create(&thread, NULL, workerLoop, (void *)(long)i) != 0)
+        {
+            perror("Echec creation d'un thread de traitement.\n");
+            exit(EXIT_FAILURE);
+        }
+        pthread_detach(thread);
+    }
+    printf("Ordonnancement %s : %d threads de traitement%s, poids reservations %d / consultations %d.\n",
+        work_stealing ? "avec vol de travail" : "central", nb_workers,
+        coroutine_mode ? " en coroutines" : "", SCHED_WEIGHT_RESERVE, SCHED_WEIGHT_CONSULT);
+}
+
+/**
+ * @brief Affiche les compteurs de l'ordonnanceur (sommes sur tous les ordonnanceurs)
+ */
+void printSchedulerStats()
+{
+    unsigned long queued[NB_CLASSES] = {0};
+    unsigned long served[NB_CLASSES] = {0};
+    unsigned long stolen = 0;
+
+    for (int s = 0; s < nb_schedulers; s++)
+    {
+        pthread_mutex_lock(&schedulers[s].mutex);
+        for (int i = 0; i < NB_CLASSES; i++)
+        {
+            queued[i] += schedulers[s].classes[i].nb_queued;
+            served[i] += schedulers[s].classes[i].nb_served;
+        }
+        stolen += schedulers[s].nb_stolen;
+        pthread_mutex_unlock(&schedulers[s].mutex);
+    }
+    printf("Ordonnancement %s : %d threads ; reservations %lu en file, %lu servies ; "
+        "consultations %lu en file, %lu servies.\n",
+        work_stealing ? "avec vol de travail" : "central", nb_workers,
+        queued[CLASS_RESERVE], served[CLASS_RESERVE], queued[CLASS_CONSULT], served[CLASS_CONSULT]);
+    if (work_stealing)
+    {
+        printf("Ordonnancement : %lu requetes volees par un autre thread.\n", stolen);
+    }
+}
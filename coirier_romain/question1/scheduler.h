@@ -0,0 +1,68 @@
+/*******************************************************************************
+ * @file scheduler.h
+ * @brief Ordonnancement équitable des requêtes du serveur de la question 1.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * Les requêtes admises ne sont plus confiées chacune à un nouveau thread :
+ * elles sont rangées par l'ordonnanceur puis traitées par un groupe fixe
+ * de threads de traitement (option -w du serveur).
+ *
+ * Deux niveaux d'équité :
+ * -> entre classes de requêtes, file équitable pondérée (WFQ) : chaque classe
+ *    a un temps virtuel qui avance de SCHED_VTIME_UNIT / poids à chaque requête
+ *    servie, la classe non vide de plus petit temps virtuel est servie.
+ *    Les réservations (et toutes les requêtes modifiant les places) pèsent
+ *    SCHED_WEIGHT_RESERVE, les consultations SCHED_WEIGHT_CONSULT : pendant une
+ *    rafale de consultations, les réservations gardent 4 services sur 5.
+ * -> dans une classe, une file par client (pid), servies à tour de rôle :
+ *    un client très actif ne retarde les autres que d'une requête par tour.
+ *
+ * Vol de travail (option -S du serveur) : au lieu d'un ordonnanceur central,
+ * chaque thread de traitement a le sien, alimenté par les clients qui lui sont
+ * associés (hachage du pid). Un thread sans travail prend la prochaine requête
+ * d'un autre thread : le verrou central disparaît, les requêtes d'un client
+ * restent sur un même coeur, et l'équité est tenue par chaque ordonnanceur.
+ * bench_scheduler.c compare les deux modes.
+ *
+ * Les threads de traitement peuvent aussi exécuter chaque requête dans une
+ * coroutine (option -C du serveur, cf coroutine.h).
+ *
+ * @note au delà de SCHED_MAX_FLOWS clients en file dans une classe, les requêtes
+ * des clients suivants partagent une file commune.
+ ******************************************************************************/
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include "common.h"
+
+#define DEFAULT_NB_WORKERS 16 // nb de threads de traitement
+#define SCHED_WEIGHT_RESERVE 4 // poids des requêtes modifiant les places
+#define SCHED_WEIGHT_CONSULT 1 // poids des consultations
+#define SCHED_VTIME_UNIT 3600 // coût d'une requête en temps virtuel (divisible par les poids)
+#define SCHED_MAX_FLOWS 1024 // nb de files client par classe
+#define SCHED_HASH_SIZE 256 // nb d'entrées de la table de recherche des files (puissance de 2)
+
+// Classes de requêtes
+typedef enum {
+    CLASS_RESERVE, // réservation, pré-réservation, confirmation, libération, annulation
+    CLASS_CONSULT, // consultation
+    NB_CLASSES
+} RequestClass;
+
+// Requête en attente de traitement
+typedef struct Task {
+    Request msg_req;
+    struct Task *next; // suivante dans la file du client
+} Task;
+
+//prototypes de fonctions
+void initScheduler(int nb_workers, bool work_stealing, bool coroutines, void (*handler)(Task *task));
+void submitTask(Task *task);
+Task *takeTask(int worker);
+void waitForTask();
+void printSchedulerStats();
+
+#endif
@@ -8,16 +8,42 @@
  * cf common.h
  * Ce serveur extrait les requetes client d'une file de message. 
  * suivant qu'il s'agissent d'une requete de consultation ou de réservation, 
- * un thread est crée exécutant la fonction correspondante puis envoyant une réponse au client.  
+ * la requête est confiée à un groupe de threads (cf scheduler.h), qui exécutent la fonction
+ * correspondante puis envoient une réponse au client.  
  * 
  * @note Plusieurs threads pouvant être concurrents en lecture ou en écriture sur 
  * le tableau des spectacles (la ressource critique), on utilise ici un algo de synchronisation type lecteur rédacteur 
  * 
+ * Les pré-réservations (blocage temporaire de places) sont gérées par le module holds.c,
+ * les réservations annulables par le module bookings.c
+ * et les listes d'attente des spectacles complets par le module waitlist.c
+ * 
+ * Le débit de chaque client est limité (option -r, cf rate_limit.h),
+ * le nb de requêtes en cours de traitement est borné (option -m, cf admission.h),
+ * les refus sont différés plutôt que perdus si la file est pleine (cf pending_replies.h),
+ * les statistiques sont affichées sur SIGUSR1 (cf stats.h),
+ * avec les compteurs matériels des opérations en option -P (cf perf_counters.h)
+ * et le profil d'attente du verrou lecteurs / rédacteur (cf lock_profile.h)
+ * 
  * @bug :  * @bug : En cas d'erreurs, les ressources ne sont pas toujours libérées correctement,
  * aussi il arrive de devoir relnacer le server et de le fermer avant de récupérer un fonctionnement normal.
  ******************************************************************************/
 
 #include "common.h"
+#include "server.h"
+#include "holds.h"
+#include "bookings.h"
+#include "waitlist.h"
+#include "dedup.h"
+#include "admission.h"
+#include "stats.h"
+#include "scheduler.h"
+#include "rate_limit.h"
+#include "coroutine.h"
+#include "request_pool.h"
+#include "perf_counters.h"
+#include "lock_profile.h"
+#include "pending_replies.h"
 
 #include <pthread.h>
 #include <sys/sem.h>
@@ -30,8 +56,6 @@ int msg_queue_id; // l'identifiant de la file de messages System V
 int semset_id; // l'identifiant du tableau des sméphores System V
 int nb_readers; // nb de lecteurs qui accèdent notre tableau à un instant t
 
-Message *shows; // pointeur vers le futur tableau (partagé nativement par tous les threads)
-
 //Prototypes
 void sigint_handler(int sig);
 
@@ -42,46 +66,98 @@ int getNbShows();
 void setupMsgQueue(key_t key);
 void initServer();
 
-void bookSeats(Message *msg);
 void getNbSeats(Message *msg);
+void sendResponse(const Request *msg_req, Response *msg_resp);
+void sendBusyResponse(const Request *msg_req, int retry_after_ms);
+
+void consultation(const Request *msg_req);
+void reservation(const Request *msg_req);
+void cancellation(const Request *msg_req);
+void holdManagement(const Request *msg_req);
+void processTask(Task *task);
+
+/**
+ * @brief Envoie la réponse d'une requête au client
+ *
+ * L'identifiant de la requête est recopié dans la réponse,
+ * qui est conservée pour les rejeux éventuels (cf dedup.h)
+ *
+ * @param msg_req la requête traitée
+ * @param msg_resp la réponse préparée (type : pid du client)
+ */
+void sendResponse(const Request *msg_req, Response *msg_resp) {
+    PerfSample sample;
+
+    msg_resp->request_id = msg_req->request_id;
+    msg_resp->retry_after_ms = 0;
+    completeRequest(msg_req, msg_resp);
+    // attente de place dans la file : suspension de la coroutine éventuelle
+    startPerfSample(&sample);
+    if (msgsndYield(msg_queue_id, msg_resp, sizeof(Response) - sizeof(long)) == -1)
+    {
+        perror("Echec msgsnd.\n");
+        exit(EXIT_FAILURE);
+    }
+    stopPerfSample(&sample, PERF_SEND);
+    releaseRequest(); // fin de la requête admise par main()
+}
+
+/**
+ * @brief Refuse une requête, serveur saturé ou client trop bavard
+ * (cf admission.h, rate_limit.h)
+ *
+ * La réponse est envoyée sans attente : une file pleine ne doit pas bloquer
+ * la boucle de réception, elle est alors différée (cf pending_replies.h).
+ *
+ * @param msg_req la requête refusée
+ * @param retry_after_ms le délai de réémission conseillé au client
+ */
+void sendBusyResponse(const Request *msg_req, int retry_after_ms)
+{
+    Response msg_resp;
+
+    msg_resp.msg_type = msg_req->pid;
+    msg_resp.msg = msg_req->msg;
+    msg_resp.ticket = 0;
+    msg_resp.status = STATUS_BUSY;
+    msg_resp.request_id = msg_req->request_id;
+    msg_resp.retry_after_ms = retry_after_ms;
+    sendReplyNoWait(&msg_resp);
+}
 
 /**
- * @brief thread de gestion des requetes de consultation
+ * @brief gestion des requetes de consultation (thread de traitement)
  *
  * Récupère le nombre de places libres pour le spectacle demandé
  * Renvoie la réponse par la file de message (pid du client comme type)
  * 
  * @note la lecture du nombre de place de getNBSeats() se fait de façon synchronisée 
  *  
- * @param void* un pointeur déréférencé vers une structure de requete.
+ * @param msg_req la requête à traiter
  */
-void* consultation(void* arg) {
+void consultation(const Request *msg_req) {
     //affichage du thread id
     char process_name[30];
     sprintf(process_name, "Thread N %d", (int) syscall(SYS_gettid));
-    printf("%s : Demarrage thread de consultation.\n", process_name);
+    printf("%s : Traitement de consultation.\n", process_name);
 
-    Request msg_req = *(Request*)arg; //on recaste l'argument dans une struct Requete
     Response msg_resp;
-    int return_value;
+    PerfSample sample;
 
     //préparation de la réponse
-    msg_resp.msg_type = msg_req.pid; //pid du client pour récupération par le process adéquat
-    strncpy(msg_resp.msg.show_id, msg_req.msg.show_id, SHOW_ID_LEN);
+    msg_resp.msg_type = msg_req->pid; //pid du client pour récupération par le process adéquat
+    msg_resp.ticket = 0;
+    msg_resp.status = STATUS_OK;
+    strncpy(msg_resp.msg.show_id, msg_req->msg.show_id, SHOW_ID_LEN);
+    startPerfSample(&sample);
     getNbSeats(&msg_resp.msg); // lecture du nb de palce de façon synchronisée
+    stopPerfSample(&sample, PERF_CONSULT);
     // envoi de la réponse
-    if ((return_value = msgsnd(msg_queue_id, &msg_resp,
-        sizeof(Response) - sizeof(long), 0)) == -1)
-    {
-        perror("Echec msgsnd.\n");
-        exit(EXIT_FAILURE);
-    }
-
-    pthread_exit(NULL);
+    sendResponse(msg_req, &msg_resp);
 }
 
 /**
- * @brief thread de gestion des requetes de réservation
+ * @brief gestion des requetes de réservation (thread de traitement)
  *
  * Réserver, si possible, un nb de places pour le spectacle demandé
  * Renvoie la réponse par la file de message (pid du client comme type)
@@ -89,30 +165,113 @@ void* consultation(void* arg) {
  * @note la vérification du nb de places restantes ainsi que
  * la mise à jour de l'entrée (bookSeats()) se fait de façon synchronisée 
  *  
- * @param void* un pointeur déréférencé vers une structure de requete.
+ * @param msg_req la requête à traiter
  */
-void* reservation(void* arg) {
+void reservation(const Request *msg_req) {
     //affichage du thread id
     char process_name[30];
     sprintf(process_name, "Thread N %d", (int) syscall(SYS_gettid));
-    printf("%s : Demarrage thread de reservation.\n", process_name);
+    printf("%s : Traitement de reservation.\n", process_name);
 
-    Request msg_req = *(Request*)arg; //on recaste l'argument dans une struct Requete
     Response msg_resp;
-    int return_value;
+    PerfSample sample;
    
     //préparation de la réponse
-    msg_resp.msg_type = msg_req.pid;
-    msg_resp.msg = msg_req.msg;
-    bookSeats(&msg_resp.msg);
+    msg_resp.msg_type = msg_req->pid;
+    msg_resp.msg = msg_req->msg;
+    // numéro de réservation, avec mise en liste d'attente éventuelle du client
+    startPerfSample(&sample);
+    msg_resp.ticket = bookSeats(&msg_resp.msg,
+        msg_req->request_type == REQUEST_WAITLIST ? msg_req->pid : 0, &msg_resp.status);
+    stopPerfSample(&sample, PERF_BOOK);
     // envoi de la réponse
-    if ((return_value = msgsnd(msg_queue_id, &msg_resp, sizeof(Response) - sizeof(long), 0)) == -1)
-    {
-        perror("Echec msgsnd.\n");
-        exit(EXIT_FAILURE);
+    sendResponse(msg_req, &msg_resp);
+}
+
+/**
+ * @brief gestion des requetes d'annulation (thread de traitement)
+ *
+ * Annule la réservation dont le numéro est fourni, les places sont rendues au spectacle
+ * Renvoie la réponse par la file de message (pid du client comme type)
+ *
+ * @param msg_req la requête à traiter
+ */
+void cancellation(const Request *msg_req) {
+    //affichage du thread id
+    char process_name[30];
+    sprintf(process_name, "Thread N %d", (int) syscall(SYS_gettid));
+    printf("%s : Traitement d'annulation.\n", process_name);
+
+    Response msg_resp;
+
+    //préparation de la réponse
+    msg_resp.msg_type = msg_req->pid;
+    msg_resp.msg = msg_req->msg;
+    msg_resp.status = STATUS_OK;
+    msg_resp.ticket = cancelBooking(msg_req->ticket, &msg_resp.msg) ? msg_req->ticket : 0;
+    // envoi de la réponse
+    sendResponse(msg_req, &msg_resp);
+}
+
+/**
+ * @brief gestion des requetes de pré-réservation, confirmation et libération (thread de traitement)
+ *
+ * Pré-réservation : bloque les places et renvoie un ticket (cf holds.h)
+ * Confirmation / libération : traite la pré-réservation du ticket fourni
+ * Renvoie la réponse par la file de message (pid du client comme type)
+ *
+ * @param msg_req la requête à traiter
+ */
+void holdManagement(const Request *msg_req) {
+    //affichage du thread id
+    char process_name[30];
+    sprintf(process_name, "Thread N %d", (int) syscall(SYS_gettid));
+    printf("%s : Traitement de pre-reservation.\n", process_name);
+
+    Response msg_resp;
+
+    //préparation de la réponse
+    msg_resp.msg_type = msg_req->pid;
+    msg_resp.msg = msg_req->msg;
+    msg_resp.status = STATUS_OK;
+    switch (msg_req->request_type) {
+        case REQUEST_HOLD:
+            msg_resp.ticket = holdSeats(&msg_resp.msg);
+            break;
+        case REQUEST_CONFIRM:
+            msg_resp.ticket = confirmHold(msg_req->ticket, &msg_resp.msg); // numéro de réservation
+            break;
+        default: // REQUEST_RELEASE
+            msg_resp.ticket = releaseHold(msg_req->ticket, &msg_resp.msg) ? msg_req->ticket : 0;
+            break;
     }
+    // envoi de la réponse
+    sendResponse(msg_req, &msg_resp);
+}
 
-    pthread_exit(NULL);
+/**
+ * @brief Traite une requête confiée par l'ordonnanceur (thread de traitement)
+ *
+ * @param task la requête, son emplacement est rendu après traitement
+ */
+void processTask(Task *task)
+{
+    switch (task->msg_req.request_type) {
+        case REQUEST_CONSULT:
+            consultation(&task->msg_req);
+            break;
+        case REQUEST_RESA:
+        case REQUEST_WAITLIST:
+            reservation(&task->msg_req);
+            break;
+        case REQUEST_CANCEL:
+            cancellation(&task->msg_req);
+            break;
+        default: // REQUEST_HOLD, REQUEST_CONFIRM, REQUEST_RELEASE
+            holdManagement(&task->msg_req);
+            break;
+    }
+    recycleTask(task); // réponse envoyée : l'emplacement peut resservir
 }
 
 /**
@@ -120,45 +279,180 @@ void* reservation(void* arg) {
  *  des requetes clients entrantes sur la message queue
  *
  * Un seul msg type est utilisé (1),
- * les types de requetes sont différenciés par le nb de places demandées
- * (0 == requête en consultation) cf common.h
+ * les types de requetes sont différenciés par le champ request_type cf common.h
+ * 
+ * les rejeux d'une requête déjà traitée ou en cours sont filtrés
+ * avant l'ordonnancement (cf dedup.h)
+ * 
+ * au delà de max_in_flight requêtes en cours, les requêtes sont refusées
+ * sans être ordonnancées (cf admission.h)
+ * 
+ * les requêtes d'un client au delà de son débit autorisé sont refusées
+ * avant le contrôle d'admission (cf rate_limit.h)
+ * 
+ * les requêtes admises sont traitées par un groupe de nb_workers threads,
+ * dans l'ordre équitable fixé par l'ordonnanceur, central ou avec vol de travail (-S)
+ * (cf scheduler.h), éventuellement en coroutines (-C, cf coroutine.h)
+ * 
+ * chaque requête est reçue directement dans un emplacement pré-alloué,
+ * confié tel quel au thread de traitement (cf request_pool.h)
+ * 
+ * option -P : compteurs matériels des opérations (cf perf_counters.h)
+ * Utilisation : ./server [-m max_in_flight] [-w nb_workers] [-S] [-C] [-r rate_limit] [-P]
  */
-int main(void){
+int main(int argc, char *argv[]){
 
     printf("PROJET NSY103 - QUESTION 1.\n");
     printf("Serveur.\n");
     printf("===========================\n");
 
     int return_value;
-    Request msg_req;
+    Response msg_resp;
+    int max_in_flight = DEFAULT_MAX_IN_FLIGHT;
+    int nb_workers = DEFAULT_NB_WORKERS;
+    bool work_stealing = false;
+    bool coroutines = false;
+    int rate_limit = DEFAULT_RATE_LIMIT;
+    bool perf_counters = false;
+    int retry_after_ms;
+    int option;
+    PerfSample sample;
+
+    while ((option = getopt(argc, argv, "m:w:SCr:P")) != -1) {
+        switch (option) {
+            case 'm':
+                max_in_flight = atoi(optarg);
+                break;
+            case 'w':
+                nb_workers = atoi(optarg);
+                break;
+            case 'S':
+                work_stealing = true;
+                break;
+            case 'C':
+                coroutines = true;
+                break;
+            case 'r':
+                rate_limit = atoi(optarg);
+                break;
+            case 'P':
+                perf_counters = true;
+                break;
+            default:
+                fprintf(stderr, "Utilisation : %s [-m max_in_flight] [-w nb_workers] [-S] [-C] [-r rate_limit] [-P]\n", argv[0]);
+                exit(EXIT_FAILURE);
+        }
+    }
+    if (max_in_flight < 1) {
+        fprintf(stderr, "Nb max de requetes en cours non valide.\n");
+        exit(EXIT_FAILURE);
+    }
+    if (rate_limit < 0) {
+        fprintf(stderr, "Debit par client non valide (0 : pas de limite).\n");
+        exit(EXIT_FAILURE);
+    }
+    if (nb_workers < 1) {
+        fprintf(stderr, "Nb de threads de traitement non valide.\n");
+        exit(EXIT_FAILURE);
+    }
     
     //mise en place des sémaphores, de la queue et de la ressource (tableau des spectacles)
     initServer();
+    initPerfCounters(perf_counters);
+    initRateLimit(rate_limit);
+    initAdmission(max_in_flight);
+    initScheduler(nb_workers, work_stealing, coroutines, processTask);
+    initRequestPool(max_in_flight + nb_workers + 1);
+
+    // emplacement de réception de la prochaine requête (cf request_pool.h)
+    Task *task = acquireTask();
+    Request *msg_req = &task->msg_req;
 
     while(1) {
         printf("Serveur en attente de requetes reservation ou consultation...\n");
         // attente de la réception d'une requete
-        if ((return_value = msgrcv(msg_queue_id, &msg_req,
-            sizeof(Request) - sizeof(long), MESSAGE_TYPE, 0)) == -1)
+        startPerfSample(&sample);
+        // (sans bloquer tant que des réponses attendent de la place dans la file)
+        if ((return_value = receiveAndFlush(msg_req, MESSAGE_TYPE)) == -1)
         {
             perror("Echec msgrcv.\n");
             exit(EXIT_FAILURE);
         }
+        stopPerfSample(&sample, PERF_RECEIVE);
 
-        // création d'un thread spécifique pour traiter la requete client
-        pthread_t thread;
-        if(msg_req.msg.nb_seats == 0) {
-            printf("Requete de Consultation pour le spectacle %s.\n",
-             msg_req.msg.show_id);
-            pthread_create(&thread, NULL, consultation,(void *)&msg_req);
-        } else {
-            printf("Requete de Reservation de %d places pour le spectacle %s.\n",
-             msg_req.msg.nb_seats, msg_req.msg.show_id);
-            pthread_create(&thread, NULL, reservation,(void *)&msg_req);
+        // type inconnu : écarté avant le filtrage des rejeux,
+        // qui le laisserait en cours de traitement (sans réponse aux réémissions)
+        if (msg_req->request_type < REQUEST_CONSULT || msg_req->request_type > REQUEST_WAITLIST)
+        {
+            fprintf(stderr, "Type de requete inconnu : %d.\n", msg_req->request_type);
+            continue;
+        }
+
+        // limitation du débit du client, avant qu'il ne consomme une place
+        if (!allowRequest(msg_req->pid, &retry_after_ms))
+        {
+            sendBusyResponse(msg_req, retry_after_ms);
+            continue;
+        }
+
+        // contrôle d'admission : refus immédiat si le serveur est saturé
+        if (!admitRequest())
+        {
+            sendBusyResponse(msg_req, getRetryAfterMs());
+            continue;
+        }
+
+        // filtrage des rejeux
+        switch (beginRequest(msg_req, &msg_resp)) {
+            case DEDUP_DONE:
+                // déjà traitée : on renvoie la même réponse, sans attente
+                // (seul lecteur de la file, cf pending_replies.h)
+                printf("Rejeu de la requete %u du client %d : reponse renvoyee.\n",
+                 msg_req->request_id, msg_req->pid);
+                sendReplyNoWait(&msg_resp);
+                releaseRequest();
+                continue;
+            case DEDUP_PENDING:
+                // en cours : la réponse de la requête d'origine arrivera
+                printf("Rejeu de la requete %u du client %d : en cours de traitement.\n",
+                 msg_req->request_id, msg_req->pid);
+                releaseRequest();
+                continue;
+            default: // DEDUP_NEW
+                break;
+        }
+
+        switch (msg_req->request_type) {
+            case REQUEST_CONSULT:
+                printf("Requete de Consultation pour le spectacle %s.\n",
+                 msg_req->msg.show_id);
+                break;
+            case REQUEST_RESA:
+            case REQUEST_WAITLIST:
+                printf("Requete de Reservation de %d places pour le spectacle %s%s.\n",
+                 msg_req->msg.nb_seats, msg_req->msg.show_id,
+                 msg_req->request_type == REQUEST_WAITLIST ? " (liste d'attente)" : "");
+                break;
+            case REQUEST_HOLD:
+                printf("Requete de Pre-reservation de %d places pour le spectacle %s.\n",
+                 msg_req->msg.nb_seats, msg_req->msg.show_id);
+                break;
+            case REQUEST_CONFIRM:
+            case REQUEST_RELEASE:
+                printf("Requete de %s du ticket %u.\n",
+                 msg_req->request_type == REQUEST_CONFIRM ? "Confirmation" : "Liberation",
+                 msg_req->ticket);
+                break;
+            case REQUEST_CANCEL:
+                printf("Requete d'Annulation de la reservation %u.\n", msg_req->ticket);
+                break;
         }
-        // on ne pourra pas resynchro avec le thread a l'aide d'un join
-        // donc on détache et on laisse le Système d'Exploitation gérer ça
-        pthread_detach(thread); 
+
+        // rangement dans la file du client, traitement par un thread du groupe :
+        // l'emplacement lui appartient désormais, le prochain msgrcv se fera dans un autre
+        submitTask(task);
+        task = acquireTask();
+        msg_req = &task->msg_req;
     }
 }
 
@@ -179,7 +473,7 @@ void sigint_handler(int sig) {
     semctl(semset_id, NB_READERS_MUTEX, IPC_RMID, 0); //suprimer 1 les supprime tous
 
     printf("Liberation de la memoire.\n");
-    free(shows);
+    freeShowTable();
     
     printf("Au revoir.\n");
     exit(EXIT_SUCCESS);
@@ -217,6 +511,8 @@ void initServer()
 
     // mise en place du handler d'interruption de l'exécution
     setupSignalHandlers();
+    // thread d'affichage des statistiques (avant tout autre thread, cf stats.h)
+    initStats();
 
     // Génération de la clé pour le sémaphore
     key_t key = ftok(KEY_FILENAME, KEY_ID);
@@ -226,8 +522,16 @@ void initServer()
     setupMsgQueue(key);
 
     //allocation et remplissage du tableau des spectacles
-    shows = (Message *) malloc((getNbShows() + 1) * sizeof(Message));
+    allocShowTable(getNbShows());
     populateResource();
+    initLockProfile(getNbShows());
+    printf("Disposition du tableau des spectacles : %s.\n", getShowTableLayout());
+
+    // listes d'attente, tables des réservations et des pré-réservations
+    // (avec roue de temporisation et thread d'expiration)
+    initWaitlists(getNbShows());
+    initBookings();
+    initHolds();
 
 }
 
@@ -274,40 +578,29 @@ void setupSemaphoreSet(key_t key) {
  * en appliquant une synchronisation de type lecteurs/rédacteur avec file d'attente
  * 
  * @note le nombre de places est décidé au hasard entre 16 et 30
- * un indicateur de fin de tableau est signifié par tous les bits de la structure à 0
+ * un indicateur de fin de tableau est signifié par un identifiant vide (et 0 place)
  */
 void populateResource()
 {
     printf("Remplissage de la ressource.\n");
     //accès en écriture sur la ressource partagée => on protège par sémaphores
-    struct sembuf operations[3];
-
-    // prélude
-    operations[0].sem_num = QUEUE_SEM;
-    operations[0].sem_op = -1; // ServiceQueue.P()
-    operations[1].sem_num = RESOURCE_SEM;
-    operations[1].sem_op = -1; // Ressource.P()
-    operations[2].sem_num = QUEUE_SEM;
-    operations[2].sem_op = 1; // ServiceQueue.V()
-    semop(semset_id, operations, 3);
+    enterWriteSection();
 
     // Entrée en section critique
         // instanciation du tableau des spectacles
         int i = 0;
         while (SHOW_IDS[i] != NULL)
         {
-            strncpy(shows[i].show_id, SHOW_IDS[i], SHOW_ID_LEN);
-            shows[i].nb_seats = 16 + rand() % 15;
+            strncpy(SHOW_ID(i), SHOW_IDS[i], SHOW_ID_LEN);
+            SHOW_SEATS(i) = 16 + rand() % 15;
             i++;
         }
         // terminaison du tableau
-        memset(&shows[++i], 0, sizeof(Message));
+        SHOW_ID(i)[0] = '\0';
+        SHOW_SEATS(i) = 0;
     // Sortie de section critique
 
-    // postlude
-    operations[0].sem_num = RESOURCE_SEM;
-    operations[0].sem_op = 1; // Ressource.V()
-    semop(semset_id, operations, 1);
+    leaveWriteSection();
 }
 
 
@@ -354,60 +647,105 @@ void setupMsgQueue(key_t key) {
 }
 
 /**
- * @brief retourne le nb de place d'un spectacle passé en paramètre
- * 
- * l'accès en lecture à la ressource est protégé par un algo de synchro 
- * type lecteur rédacteur avec principe d'équité assuré par le sémaphore QUEUE_SEM
+ * @brief Recherche l'index d'un spectacle dans le tableau des spectacles
  * 
- * note : la partie recherche d'index est hors de la section critique
+ * note : les identifiants ne sont jamais modifiés après le remplissage,
+ * la recherche se fait donc hors section critique
  * 
- * @param Message* un pointeur qui va recevoir le nb de places
+ * @param show_id l'identifiant du spectacle
+ * @return int : l'index du spectacle, -1 s'il n'existe pas
  */
-void getNbSeats(Message *msg) {
-    struct sembuf operations[2];
-    // recherche de l'index du spectacle
-    bool found = false;
-    int i = -1;
-    while(!found && (shows[++i].show_id[0] != '\0')) {
-        found = strcmp(msg->show_id, shows[i].show_id) == 0;
+int findShowIndex(const char *show_id)
+{
+    int i = 0;
+    while (SHOW_ID(i)[0] != '\0')
+    {
+        if (strcmp(show_id, SHOW_ID(i)) == 0)
+        {
+            return i;
+        }
+        i++;
     }
-    if(!found) {
-        //le spectacle demandé n'a pas été trouvé dans la liste
-        //on met tous les bits du message à 0 pour le signifier
-        memset(msg, 0, sizeof(Message));
-        return;
+    return -1;
+}
+
+/**
+ * @brief semopYield() précédé d'un essai sans attente (profil du verrou, cf lock_profile.h)
+ *
+ * @return bool : true si les opérations ont dû attendre un autre thread
+ */
+static bool semopContended(struct sembuf *operations, int nb_operations)
+{
+    int return_value;
+
+    for (int i = 0; i < nb_operations; i++)
+    {
+        operations[i].sem_flg |= IPC_NOWAIT;
     }
-    
-    //accès en écriture sur la ressource partagée => on protège par sémaphores
+    return_value = semop(semset_id, operations, nb_operations);
+    for (int i = 0; i < nb_operations; i++)
+    {
+        operations[i].sem_flg &= ~IPC_NOWAIT;
+    }
+    if (return_value == 0 || errno != EAGAIN)
+    {
+        return false;
+    }
+    semopYield(semset_id, operations, nb_operations);
+    return true;
+}
+
+/**
+ * @brief Prélude lecteur : entrée en section critique en lecture sur shows[]
+ * 
+ * algo de synchro type lecteur rédacteur avec principe d'équité assuré par le sémaphore QUEUE_SEM
+ * le premier lecteur bloque la ressource pour les rédacteurs
+ * 
+ * note : en mode coroutines, les attentes suspendent la coroutine (cf coroutine.h)
+ *
+ * @return bool : true s'il a fallu attendre (cf lock_profile.h)
+ */
+bool enterReadSection()
+{
+    bool contended;
+    struct sembuf operations[2];
 
-    // prélude
     operations[0].sem_num = QUEUE_SEM;
     operations[0].sem_op = -1; // ServiceQueue.P()
+    operations[0].sem_flg = 0;
     operations[1].sem_num = NB_READERS_MUTEX;
     operations[1].sem_op = -1; // nb_readers.P()
-    semop(semset_id, operations, 2);
+    operations[1].sem_flg = 0;
+    contended = semopContended(operations, 2);
         //mini section critique
         nb_readers++;
         if(nb_readers == 1) {
             //on est le premier lecteur sur la ressource
             operations[0].sem_num = RESOURCE_SEM;
             operations[0].sem_op = -1; // Ressource.P()
-            semop(semset_id, operations, 1);        
+            contended |= semopContended(operations, 1);
         }
     operations[0].sem_num = QUEUE_SEM;
     operations[0].sem_op = 1; // ServiceQueue.V()
     operations[1].sem_num = NB_READERS_MUTEX;
     operations[1].sem_op = 1; // nb_readers.V()
     semop(semset_id, operations, 2);
+    return contended;
+}
 
-    // Entrée en section critique
-        msg->nb_seats = shows[i].nb_seats;
-    // Sortie de section critique
+/**
+ * @brief Postlude lecteur : sortie de section critique en lecture sur shows[]
+ * 
+ * le dernier lecteur libère la ressource pour les rédacteurs
+ */
+void leaveReadSection()
+{
+    struct sembuf operations[1];
 
-    // postlude
     operations[0].sem_num = NB_READERS_MUTEX;
     operations[0].sem_op = -1; // nb_readers.P()
-    semop(semset_id, operations, 1);
+    operations[0].sem_flg = 0;
+    semopYield(semset_id, operations, 1);
         //mini section critique
         nb_readers--;
         if(nb_readers == 0) {
@@ -422,9 +760,79 @@ void getNbSeats(Message *msg) {
 }
 
 /**
- * @brief Tente de Réserver le nb de place demandé pour le spectacle passé en paramètre
+ * @brief Prélude rédacteur : entrée en section critique en écriture sur shows[]
+ * 
+ * le passage par QUEUE_SEM garantit l'équité entre lecteurs et rédacteurs
+ *
+ * @return bool : true s'il a fallu attendre (cf lock_profile.h)
+ */
+bool enterWriteSection()
+{
+    struct sembuf operations[3];
+
+    operations[0].sem_num = QUEUE_SEM;
+    operations[0].sem_op = -1; // ServiceQueue.P()
+    operations[0].sem_flg = 0;
+    operations[1].sem_num = RESOURCE_SEM;
+    operations[1].sem_op = -1; // Ressource.P()
+    operations[1].sem_flg = 0;
+    operations[2].sem_num = QUEUE_SEM;
+    operations[2].sem_op = 1; // ServiceQueue.V()
+    operations[2].sem_flg = 0;
+    return semopContended(operations, 3);
+}
+
+/**
+ * @brief Postlude rédacteur : sortie de section critique en écriture sur shows[]
+ */
+void leaveWriteSection()
+{
+    struct sembuf operations[1];
+
+    operations[0].sem_num = RESOURCE_SEM;
+    operations[0].sem_op = 1; // Ressource.V()
+    operations[0].sem_flg = 0;
+    semop(semset_id, operations, 1);
+}
+
+/**
+ * @brief retourne le nb de place d'un spectacle passé en paramètre
+ * 
+ * l'accès en lecture à la ressource est protégé par un algo de synchro 
+ * type lecteur rédacteur avec principe d'équité assuré par le sémaphore QUEUE_SEM
+ * 
+ * note : la partie recherche d'index est hors de la section critique
+ * 
+ * @param Message* un pointeur qui va recevoir le nb de places
+ */
+void getNbSeats(Message *msg) {
+    // recherche de l'index du spectacle
+    int i = findShowIndex(msg->show_id);
+    if(i == -1) {
+        //le spectacle demandé n'a pas été trouvé dans la liste
+        //on met tous les bits du message à 0 pour le signifier
+        memset(msg, 0, sizeof(Message));
+        return;
+    }
+    
+    //accès en lecture sur la ressource partagée => on protège par sémaphores
+    LockTiming timing;
+    beginLockWait(&timing);
+    lockAcquired(&timing, enterReadSection());
+    // Entrée en section critique
+        msg->nb_seats = SHOW_SEATS(i);
+    // Sortie de section critique
+    lockReleased(&timing, LOCK_CONSULT, i);
+    leaveReadSection();
+}
+
+/**
+ * @brief Tente de retirer le nb de place demandé pour le spectacle passé en paramètre
  * 
  * vérifie si la requete est possible (nb places restantes >= nb de places demandées)
+ * (commun aux réservations et aux pré-réservations)
+ * si elle ne l'est pas et qu'un client est fourni, la demande est placée
+ * dans la liste d'attente du spectacle, dans la même section critique
  * 
  * l'accès en écriture à la ressource est protégé par un algo de synchro 
  * type lecteur rédacteur avec principe d'équité assuré par le sémaphore QUEUE_SEM
@@ -433,51 +841,109 @@ void getNbSeats(Message *msg) {
  * 
  * @param Message* nb de places > 0 : réservation acceptée pour le nb_places
  *                              <= 0 : réservation refusée nb de places restantes en négatif
+ * @param waiter_pid le client à placer en liste d'attente en cas de refus (0 : aucun)
+ * @return bool : true si la demande a été placée en liste d'attente
  */
-void bookSeats(Message *msg)
+bool takeSeats(Message *msg, pid_t waiter_pid)
 {
-    struct sembuf operations[3];
+    bool waitlisted = false;
     // recherche de l'index du spectacle
-    bool found = false;
-    int i = -1;
-    while (!found && (shows[++i].show_id[0] != '\0'))
-    {
-        found = strcmp(msg->show_id, shows[i].show_id) == 0;
-    }
-    if (!found)
+    int i = findShowIndex(msg->show_id);
+    if (i == -1)
     {
         // le spectacle demandé n'a pas été trouvé dans la liste
         // on met tous les bits du message à 0 pour le signifier
         memset(msg, 0, sizeof(Message));
-        return;
+        return false;
     }
 
     //accès en écriture sur la ressource partagée => on protège par sémaphores
-
-    // prélude
-    operations[0].sem_num = QUEUE_SEM;
-    operations[0].sem_op = -1; // ServiceQueue.P()
-    operations[1].sem_num = RESOURCE_SEM;
-    operations[1].sem_op = -1; // Ressource.P()
-    operations[2].sem_num = QUEUE_SEM;
-    operations[2].sem_op = 1; // ServiceQueue.V()
-    semop(semset_id, operations, 3);
-
+    LockTiming timing;
+    beginLockWait(&timing);
+    lockAcquired(&timing, enterWriteSection());
     // Entrée en section critique
-        if (msg->nb_seats <= shows[i].nb_seats)
+        if (msg->nb_seats <= SHOW_SEATS(i))
         {
             // il reste assez de places
-            shows[i].nb_seats = shows[i].nb_seats - msg->nb_seats;
+            SHOW_SEATS(i) = SHOW_SEATS(i) - msg->nb_seats;
         }
         else
         {
             // il ne reste pas assez de places pour honorer la réservation entière
-            msg->nb_seats = -1 * shows[i].nb_seats;
+            if (waiter_pid != 0)
+            {
+                waitlisted = enqueueWaiter(i, waiter_pid, msg->nb_seats);
+            }
+            msg->nb_seats = -1 * SHOW_SEATS(i);
         }
     // Sortie de section critique
+    lockReleased(&timing, LOCK_TAKE, i);
+    leaveWriteSection();
+    return waitlisted;
+}
 
-    // postlude
-    operations[0].sem_num = RESOURCE_SEM;
-    operations[0].sem_op = 1; // Ressource.V()
-    semop(semset_id, operations, 1);
-}
\ No newline at end of file
+/**
+ * @brief Réserve le nb de place demandé pour le spectacle passé en paramètre
+ * 
+ * retire les places (cf takeSeats()) puis enregistre la réservation,
+ * dont le numéro permettra l'annulation (cf bookings.h)
+ * 
+ * @param Message* nb de places > 0 : réservation acceptée pour le nb_places
+ *                              <= 0 : réservation refusée nb de places restantes en négatif
+ * @param waiter_pid le client à placer en liste d'attente en cas de refus (0 : aucun)
+ * @param status reçoit STATUS_WAITLISTED si la demande est en liste d'attente, STATUS_OK sinon
+ * @return unsigned int : le numéro de réservation, 0 si refusée
+ */
+unsigned int bookSeats(Message *msg, pid_t waiter_pid, int *status)
+{
+    unsigned int booking_id;
+
+    *status = takeSeats(msg, waiter_pid) ? STATUS_WAITLISTED : STATUS_OK;
+    if (msg->show_id[0] == '\0' || msg->nb_seats <= 0)
+    {
+        // spectacle inconnu ou pas assez de places
+        return 0;
+    }
+    int i = findShowIndex(msg->show_id);
+    if ((booking_id = recordBooking(i, msg->nb_seats)) == 0)
+    {
+        // table des réservations pleine : on rend les places
+        returnSeats(i, msg->nb_seats);
+        msg->nb_seats = 0;
+    }
+    return booking_id;
+}
+
+/**
+ * @brief Rend des places à un spectacle (libération d'une pré-réservation, annulation...)
+ * 
+ * l'accès en écriture à la ressource est protégé par un algo de synchro 
+ * type lecteur rédacteur avec principe d'équité assuré par le sémaphore QUEUE_SEM
+ * 
+ * les places rendues servent en priorité la liste d'attente du spectacle
+ * (dans la même section critique), les clients servis sont notifiés ensuite ;
+ * les places qui n'ont pu leur être attribuées sont rendues à nouveau (boucle)
+ * 
+ * @param show_index l'index du spectacle dans shows[]
+ * @param nb_seats le nb de places rendues
+ */
+void returnSeats(int show_index, int nb_seats)
+{
+    Waiter served[WAITLIST_MAX_SERVED];
+    int nb_served;
+    LockTiming timing;
+
+    while (nb_seats > 0)
+    {
+        beginLockWait(&timing);
+        lockAcquired(&timing, enterWriteSection());
+        // Entrée en section critique
+            SHOW_SEATS(show_index) += nb_seats;
+            nb_served = serveWaiters(show_index, served);
+        // Sortie de section critique
+        lockReleased(&timing, LOCK_RETURN, show_index);
+        leaveWriteSection();
+
+        nb_seats = notifyWaiters(show_index, served, nb_served);
+    }
+}
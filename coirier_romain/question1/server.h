@@ -0,0 +1,35 @@
+/*******************************************************************************
+ * @file server.h
+ * @brief Déclarations du serveur de la question 1 partagées avec ses modules.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * cf server.c
+ * Accès au tableau des spectacles (la ressource critique, cf show_table.h)
+ * et aux sections critiques lecteur / rédacteur qui le protègent.
+ ******************************************************************************/
+
+#ifndef SERVER_H
+#define SERVER_H
+
+#include "common.h"
+#include "show_table.h"
+
+// variables globales (définies dans server.c)
+extern int msg_queue_id;
+
+//prototypes de fonctions
+int getNbShows();
+int findShowIndex(const char *show_id);
+
+bool enterReadSection();
+void leaveReadSection();
+bool enterWriteSection();
+void leaveWriteSection();
+
+bool takeSeats(Message *msg, pid_t waiter_pid);
+unsigned int bookSeats(Message *msg, pid_t waiter_pid, int *status);
+void returnSeats(int show_index, int nb_seats);
+
+#endif
@@ -0,0 +1,69 @@
+/*******************************************************************************
+ * @file show_table.c
+ * @brief Allocation du tableau des spectacles du serveur de la question 1.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * cf show_table.h
+ ******************************************************************************/
+
+#include "show_table.h"
+
+#ifdef SEAT_TABLE_SOA
+char (*show_ids)[SHOW_ID_LEN]; // pointeurs vers les futurs tableaux
+SeatCounter *seat_counters;    // (partagés nativement par tous les threads)
+#else
+Message *shows; // pointeur vers le futur tableau (partagé nativement par tous les threads)
+#endif
+
+/**
+ * @brief Alloue le tableau des spectacles, terminaison comprise (tous les bits à 0)
+ *
+ * @param nb_shows le nb de spectacles
+ */
+void allocShowTable(int nb_shows)
+{
+#ifdef SEAT_TABLE_SOA
+    show_ids = calloc(nb_shows + 1, SHOW_ID_LEN);
+    // compteurs alignés : aucune ligne de cache partagée avec une autre donnée
+    if (show_ids == NULL
+        || posix_memalign((void **)&seat_counters, CACHE_LINE_SIZE, (nb_shows + 1) * sizeof(SeatCounter)) != 0)
+    {
+        perror("Echec allocation du tableau des spectacles.\n");
+        exit(EXIT_FAILURE);
+    }
+    memset(seat_counters, 0, (nb_shows + 1) * sizeof(SeatCounter));
+#else
+    if ((shows = (Message *)calloc(nb_shows + 1, sizeof(Message))) == NULL)
+    {
+        perror("Echec allocation du tableau des spectacles.\n");
+        exit(EXIT_FAILURE);
+    }
+#endif
+}
+
+/**
+ * @brief Libère le tableau des spectacles
+ */
+void freeShowTable()
+{
+#ifdef SEAT_TABLE_SOA
+    free(show_ids);
+    free(seat_counters);
+#else
+    free(shows);
+#endif
+}
+
+/**
+ * @brief Renvoie le nom de la disposition compilée (affichage)
+ */
+const char *getShowTableLayout()
+{
+#ifdef SEAT_TABLE_SOA
+    return "compteurs alignes sur des lignes de cache";
+#else
+    return "tableau de Message";
+#endif
+}
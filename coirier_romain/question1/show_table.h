@@ -0,0 +1,57 @@
+/*******************************************************************************
+ * @file show_table.h
+ * @brief Disposition en mémoire du tableau des spectacles du serveur de la question 1.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * Deux dispositions, choisies à la compilation :
+ * -> par défaut, un tableau de Message (8 octets) : huit spectacles partagent
+ *    chaque ligne de cache, et les réservations concurrentes de spectacles voisins
+ *    se disputent cette ligne entre les coeurs (faux partage).
+ * -> avec -DSEAT_TABLE_SOA, une structure de tableaux : les identifiants
+ *    (lus à chaque recherche, jamais modifiés) sont regroupés dans un tableau
+ *    compact, et chaque compteur de places occupe sa propre ligne de cache.
+ *
+ * Le reste du serveur n'accède au tableau qu'au travers de SHOW_ID(i) et SHOW_SEATS(i).
+ * Le tableau est terminé par une entrée d'identifiant vide.
+ ******************************************************************************/
+
+#ifndef SHOW_TABLE_H
+#define SHOW_TABLE_H
+
+#include "common.h"
+
+#define CACHE_LINE_SIZE 64
+
+#ifdef SEAT_TABLE_SOA
+
+// compteur de places seul sur sa ligne de cache
+typedef struct {
+    signed char nb_seats;
+    char padding[CACHE_LINE_SIZE - sizeof(signed char)];
+} __attribute__((aligned(CACHE_LINE_SIZE))) SeatCounter;
+
+// variables globales (définies dans show_table.c)
+extern char (*show_ids)[SHOW_ID_LEN]; // identifiants (données froides)
+extern SeatCounter *seat_counters;    // compteurs de places (données chaudes)
+
+#define SHOW_ID(i) (show_ids[i])
+#define SHOW_SEATS(i) (seat_counters[i].nb_seats)
+
+#else
+
+// variables globales (définies dans show_table.c)
+extern Message *shows;
+
+#define SHOW_ID(i) (shows[i].show_id)
+#define SHOW_SEATS(i) (shows[i].nb_seats)
+
+#endif
+
+//prototypes de fonctions
+void allocShowTable(int nb_shows);
+void freeShowTable();
+const char *getShowTableLayout();
+
+#endif
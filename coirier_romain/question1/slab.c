@@ -0,0 +1,162 @@
+/*******************************************************************************
+ * @file slab.c
+ * @brief Implémentation de l'allocateur d'objets de la question 1.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * cf slab.h
+ * Un objet libre commence par le pointeur vers l'objet libre suivant.
+ ******************************************************************************/
+
+#include "slab.h"
+
+#include <stddef.h>
+#include <sys/mman.h>
+
+// Objets libres d'une réserve gardés par un thread
+typedef struct {
+    void *objects[SLAB_CACHE_SIZE];
+    int count;
+} SlabCache;
+
+// variables du module
+static Slab *slabs[SLAB_MAX];
+static int nb_slabs;
+static __thread SlabCache caches[SLAB_MAX]; // caches du thread courant
+
+/**
+ * @brief Prépare une réserve vide
+ *
+ * @param slab la réserve
+ * @param name son nom (statistiques)
+ * @param object_size la taille d'un objet
+ * @param max_objects le nb max d'objets
+ */
+void initSlab(Slab *slab, const char *name, size_t object_size, unsigned long max_objects)
+{
+    if (nb_slabs == SLAB_MAX)
+    {
+        fprintf(stderr, "Trop de reserves d'objets.\n");
+        exit(EXIT_FAILURE);
+    }
+    memset(slab, 0, sizeof(Slab));
+    slab->name = name;
+    // place pour le chaînage, objets alignés
+    slab->object_size = (object_size < sizeof(void *)) ? sizeof(void *) : object_size;
+    slab->object_size = (slab->object_size + __alignof__(max_align_t) - 1) & ~(__alignof__(max_align_t) - 1);
+    slab->max_objects = max_objects;
+    pthread_mutex_init(&slab->mutex, NULL);
+    slab->id = nb_slabs;
+    slabs[nb_slabs++] = slab;
+}
+
+/**
+ * @brief Agrandit la réserve commune d'un bloc d'objets (sous son verrou)
+ *
+ * @return bool : false si la réserve a atteint sa limite
+ */
+static bool growSlab(Slab *slab)
+{
+    unsigned long nb = SLAB_BLOCK_OBJECTS;
+    char *block;
+
+    if (slab->nb_objects + nb > slab->max_objects)
+    {
+        nb = slab->max_objects - slab->nb_objects;
+    }
+    if (nb == 0)
+    {
+        return false;
+    }
+    block = (char *)mmap(NULL, nb * slab->object_size, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (block == MAP_FAILED)
+    {
+        return false;
+    }
+    for (unsigned long i = 0; i < nb; i++)
+    {
+        void *object = block + i * slab->object_size;
+        *(void **)object = slab->free_objects;
+        slab->free_objects = object;
+    }
+    slab->nb_objects += nb;
+    return true;
+}
+
+/**
+ * @brief Alloue un objet
+ *
+ * @param slab la réserve
+ * @return void* l'objet (non initialisé), NULL si la réserve a atteint sa limite
+ */
+void *slabAlloc(Slab *slab)
+{
+    SlabCache *cache = &caches[slab->id];
+
+    if (cache->count == 0)
+    {
+        // cache vide : remplissage de moitié depuis la réserve commune
+        pthread_mutex_lock(&slab->mutex);
+        while (cache->count < SLAB_CACHE_SIZE / 2
+            && (slab->free_objects != NULL || growSlab(slab)))
+        {
+            void *object = slab->free_objects;
+            slab->free_objects = *(void **)object;
+            cache->objects[cache->count++] = object;
+        }
+        slab->nb_used += cache->count;
+        slab->nb_refills++;
+        pthread_mutex_unlock(&slab->mutex);
+        if (cache->count == 0)
+        {
+            return NULL;
+        }
+    }
+    return cache->objects[--cache->count];
+}
+
+/**
+ * @brief Libère un objet alloué par slabAlloc()
+ *
+ * @param slab la réserve de l'objet
+ * @param object l'objet, qui ne doit plus être utilisé
+ */
+void slabFree(Slab *slab, void *object)
+{
+    SlabCache *cache = &caches[slab->id];
+
+    if (cache->count == SLAB_CACHE_SIZE)
+    {
+        // cache plein : la moitié retourne à la réserve commune
+        pthread_mutex_lock(&slab->mutex);
+        while (cache->count > SLAB_CACHE_SIZE / 2)
+        {
+            void *free_object = cache->objects[--cache->count];
+            *(void **)free_object = slab->free_objects;
+            slab->free_objects = free_object;
+            slab->nb_used--;
+        }
+        slab->nb_refills++;
+        pthread_mutex_unlock(&slab->mutex);
+    }
+    cache->objects[cache->count++] = object;
+}
+
+/**
+ * @brief Affiche l'occupation de chaque réserve
+ */
+void printSlabStats()
+{
+    for (int i = 0; i < nb_slabs; i++)
+    {
+        Slab *slab = slabs[i];
+
+        pthread_mutex_lock(&slab->mutex);
+        printf("Reserve %s : %lu objets de %zu octets obtenus (max %lu), %lu hors reserve commune, %lu echanges.\n",
+            slab->name, slab->nb_objects, slab->object_size, slab->max_objects,
+            slab->nb_used, slab->nb_refills);
+        pthread_mutex_unlock(&slab->mutex);
+    }
+}
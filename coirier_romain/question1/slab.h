@@ -0,0 +1,54 @@
+/*******************************************************************************
+ * @file slab.h
+ * @brief Allocateur d'objets de taille fixe du serveur de la question 1.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * Les petits objets alloués pendant le traitement des requêtes ne passent
+ * pas par malloc (verrou global, mémoire sans limite) mais par une réserve
+ * (Slab) d'objets de même taille :
+ * -> la mémoire est obtenue par blocs de SLAB_BLOCK_OBJECTS objets (mmap),
+ *    à la demande, dans la limite de max_objects (mémoire bornée)
+ * -> chaque thread garde un cache d'au plus SLAB_CACHE_SIZE objets libres :
+ *    allocation et libération sans verrou dans le cas courant
+ * -> un cache vide se remplit, un cache plein se vide de moitié
+ *    (SLAB_CACHE_SIZE / 2 objets) auprès de la réserve commune, sous son verrou.
+ *
+ * Un objet libéré par un autre thread que celui qui l'a alloué va dans le cache
+ * du thread qui le libère. Au plus SLAB_MAX réserves par processus.
+ *
+ * @note les objets restés dans le cache d'un thread terminé sont perdus
+ * (les threads du serveur ne se terminent pas).
+ ******************************************************************************/
+
+#ifndef SLAB_H
+#define SLAB_H
+
+#include "common.h"
+
+#include <pthread.h>
+
+#define SLAB_MAX 8 // nb max de réserves
+#define SLAB_CACHE_SIZE 32 // nb max d'objets libres dans le cache d'un thread
+#define SLAB_BLOCK_OBJECTS 64 // nb d'objets obtenus à chaque agrandissement
+
+typedef struct Slab {
+    const char *name;
+    size_t object_size;
+    unsigned long max_objects; // nb max d'objets (libres ou non)
+    int id; // index des caches de la réserve dans chaque thread
+    pthread_mutex_t mutex; // protège la suite
+    void *free_objects; // objets libres de la réserve commune (chaînés)
+    unsigned long nb_objects; // nb d'objets déjà obtenus
+    unsigned long nb_used; // nb d'objets alloués (hors caches)
+    unsigned long nb_refills; // échanges entre les caches et la réserve commune
+} Slab;
+
+//prototypes de fonctions
+void initSlab(Slab *slab, const char *name, size_t object_size, unsigned long max_objects);
+void *slabAlloc(Slab *slab);
+void slabFree(Slab *slab, void *object);
+void printSlabStats();
+
+#endif
@@ -0,0 +1,87 @@
+/*******************************************************************************
+ * @file stats.c
+ * @brief Implémentation de l'affichage des statistiques de la question 1.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * cf stats.h
+ ******************************************************************************/
+
+#include "stats.h"
+#include "admission.h"
+#include "scheduler.h"
+#include "rate_limit.h"
+#include "coroutine.h"
+#include "request_pool.h"
+#include "slab.h"
+#include "perf_counters.h"
+#include "lock_profile.h"
+
+#include <pthread.h>
+
+/**
+ * @brief Affiche les statistiques de chaque module
+ */
+void printStats()
+{
+    printf("===== Statistiques du serveur =====\n");
+    printRateLimitStats();
+    printAdmissionStats();
+    printRequestPoolStats();
+    printSchedulerStats();
+    printCoroutineStats();
+    printSlabStats();
+    printLockProfile();
+    printPerfStats();
+    printf("===================================\n");
+}
+
+/**
+ * @brief Corps du thread des statistiques : attente de SIGUSR1 puis affichage
+ *
+ * @param void* non utilisé
+ */
+static void *statsLoop(void *arg)
+{
+    sigset_t signals;
+    int sig;
+
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGUSR1);
+    while (1)
+    {
+        if (sigwait(&signals, &sig) == 0)
+        {
+            printStats();
+            fflush(stdout);
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Bloque SIGUSR1 et lance le thread des statistiques
+ *
+ * @note à appeler avant la création de tout autre thread (masque hérité)
+ */
+void initStats()
+{
+    sigset_t signals;
+    pthread_t thread;
+
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGUSR1);
+    if (pthread_sigmask(SIG_BLOCK, &signals, NULL) != 0)
+    {
+        perror("Echec pthread_sigmask.\n");
+        exit(EXIT_FAILURE);
+    }
+    if (pthread_create(&thread, NULL, statsLoop, NULL) != 0)
+    {
+        perror("Echec creation du thread des statistiques.\n");
+        exit(EXIT_FAILURE);
+    }
+    pthread_detach(thread);
+    printf("'kill -USR1 %d' pour afficher les statistiques.\n", getpid());
+}
@@ -0,0 +1,25 @@
+/*******************************************************************************
+ * @file stats.h
+ * @brief Affichage des statistiques du serveur de la question 1.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * Les statistiques des modules du serveur sont affichées à la réception de SIGUSR1 :
+ * $ kill -USR1 <pid du serveur>
+ *
+ * Le signal est bloqué dans tous les threads (initStats() est appelée avant la
+ * création du premier thread) et attendu par un thread dédié (sigwait) :
+ * l'affichage se fait donc hors gestionnaire de signal.
+ ******************************************************************************/
+
+#ifndef STATS_H
+#define STATS_H
+
+#include "common.h"
+
+//prototypes de fonctions
+void initStats();
+void printStats();
+
+#endif
@@ -0,0 +1,373 @@
+/*******************************************************************************
+ * @file stress.c
+ * @brief Test de charge du serveur de la question 1 avec contrôle des invariants.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * nb_clients process clients envoient en même temps nb_operations requêtes
+ * chacun au serveur en cours d'exécution : réservations de 1 à MAX_STRESS_SEATS
+ * places, annulations de leurs propres réservations et consultations.
+ * Chaque client tire ses requêtes d'un générateur initialisé par la graine et
+ * son numéro : une même commande rejoue les mêmes suites de requêtes (seul
+ * l'entrelacement entre clients varie d'une exécution à l'autre).
+ *
+ * Invariants vérifiés :
+ * -> chaque réponse : identifiant de requête recopié ; réservation acceptée
+ *    (numéro de réservation) pour exactement le nb de places demandé, refusée
+ *    avec un nb de places restantes entre 0 et le nb demandé - 1 ; annulation
+ *    rendant le spectacle et le nb de places de la réservation ; places restantes
+ *    jamais négatives ni supérieures à la capacité
+ * -> en fin de test (réservations restantes annulées par leur client) :
+ *    pour chaque spectacle, places vendues - places rendues + places restantes
+ *    == capacité relevée au départ, et donc places restantes == capacité.
+ * La capacité de chaque spectacle est relevée par une consultation avant le
+ * lancement des clients : le serveur ne doit pas avoir d'autres clients.
+ *
+ * Compilation :
+ * $ gcc -O2 -o stress stress.c
+ * Utilisation : ./stress [nb_clients] [nb_operations] [graine]
+ * (serveur lancé avec -r 0 et -m au moins nb_clients : sinon des requêtes
+ * sont refusées par la limitation de débit ou le contrôle d'admission,
+ * ce qui est compté à part et n'est pas une erreur ;
+ * nb de threads de traitement : option -w du serveur)
+ *
+ * @return EXIT_SUCCESS si aucun invariant n'a été violé
+ ******************************************************************************/
+
+#include "common.h"
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+#define DEFAULT_NB_CLIENTS 16
+#define DEFAULT_NB_OPERATIONS 100000 // par client
+#define DEFAULT_SEED 103
+#define MAX_STRESS_SEATS 4 // places par réservation (1 à MAX_STRESS_SEATS)
+#define MAX_CLIENT_BOOKINGS 32 // réservations gardées par un client
+#define CANCEL_PERCENT 40 // part des annulations (client ayant des réservations)
+#define CONSULT_PERCENT 20 // part des consultations
+#define MAX_REPORTED 10 // violations détaillées par client
+
+// Réservation acceptée, gardée par le client pour l'annuler
+typedef struct {
+    unsigned int ticket;
+    int show;
+    int nb_seats;
+} StressBooking;
+
+// Compteurs d'un client (projection partagée avec le père)
+// suivis de deux tableaux de nb_shows compteurs : places vendues, places rendues
+typedef struct {
+    long nb_booked; // réservations acceptées
+    long nb_refused; // réservations refusées faute de places
+    long nb_cancelled; // annulations
+    long nb_consulted; // consultations
+    long nb_busy; // requêtes refusées (débit, saturation)
+    long nb_violations; // invariants violés
+} StressCounters;
+
+static int queue_id;
+static int nb_shows;
+static int *capacities; // capacité relevée de chaque spectacle
+static unsigned int next_request_id = 1;
+
+/**
+ * @brief Tirage pseudo-aléatoire reproductible (xorshift64)
+ */
+static unsigned long nextRandom(unsigned long *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+/**
+ * @brief Envoie une requête et attend sa réponse
+ *
+ * @return bool : false si le serveur ne répond plus (file supprimée)
+ */
+static bool sendRequest(int request_type, int show, int nb_seats, unsigned int ticket,
+    Request *msg_req, Response *msg_resp)
+{
+    memset(msg_req, 0, sizeof(Request));
+    msg_req->msg_type = MESSAGE_TYPE;
+    msg_req->pid = getpid();
+    msg_req->request_type = request_type;
+    msg_req->ticket = ticket;
+    msg_req->request_id = next_request_id++;
+    memcpy(msg_req->msg.show_id, SHOW_IDS[show], SHOW_ID_LEN);
+    msg_req->msg.nb_seats = nb_seats;
+
+    return msgsnd(queue_id, msg_req, sizeof(Request) - sizeof(long), 0) != -1
+        && msgrcv(queue_id, msg_resp, sizeof(Response) - sizeof(long), msg_req->pid, 0) != -1;
+}
+
+/**
+ * @brief Signale un invariant violé (détail des MAX_REPORTED premiers)
+ */
+static void reportViolation(StressCounters *counters, int client, long operation,
+    const char *invariant, const Response *msg_resp)
+{
+    if (counters->nb_violations++ < MAX_REPORTED)
+    {
+        fprintf(stderr, "Client %d, operation %ld : %s (reponse %s %d places, ticket %u, requete %u).\n",
+            client, operation, invariant, msg_resp->msg.show_id, msg_resp->msg.nb_seats,
+            msg_resp->ticket, msg_resp->request_id);
+    }
+}
+
+/**
+ * @brief Vérifie une réponse à une requête acceptée par le serveur
+ *
+ * @param booking la réservation annulée (REQUEST_CANCEL)
+ * @param sold / returned les places vendues / rendues par spectacle
+ */
+static void checkResponse(const Request *msg_req, const Response *msg_resp, int show,
+    const StressBooking *booking, StressCounters *counters, long *sold, long *returned,
+    StressBooking *bookings, int *nb_bookings, int client, long operation)
+{
+    int nb_seats = msg_resp->msg.nb_seats;
+
+    if (msg_resp->request_id != msg_req->request_id)
+    {
+        reportViolation(counters, client, operation, "identifiant de requete non recopie", msg_resp);
+        return;
+    }
+    switch (msg_req->request_type)
+    {
+        case REQUEST_CONSULT:
+            counters->nb_consulted++;
+            if (nb_seats < 0 || nb_seats > capacities[show])
+            {
+                reportViolation(counters, client, operation, "places restantes hors de [0, capacite]", msg_resp);
+            }
+            break;
+        case REQUEST_RESA:
+            if (msg_resp->ticket != 0)
+            {
+                counters->nb_booked++;
+                if (nb_seats != msg_req->msg.nb_seats)
+                {
+                    reportViolation(counters, client, operation, "reservation acceptee pour un autre nb de places", msg_resp);
+                    break;
+                }
+                sold[show] += nb_seats;
+                bookings[*nb_bookings].ticket = msg_resp->ticket;
+                bookings[*nb_bookings].show = show;
+                bookings[*nb_bookings].nb_seats = nb_seats;
+                (*nb_bookings)++;
+            }
+            else
+            {
+                counters->nb_refused++;
+                if (nb_seats > 0 || -nb_seats >= msg_req->msg.nb_seats || -nb_seats > capacities[show])
+                {
+                    reportViolation(counters, client, operation, "refus avec des places restantes suffisantes ou hors capacite", msg_resp);
+                }
+            }
+            break;
+        case REQUEST_CANCEL:
+            counters->nb_cancelled++;
+            if (msg_resp->ticket != booking->ticket
+                || strncmp(msg_resp->msg.show_id, SHOW_IDS[booking->show], SHOW_ID_LEN) != 0
+                || nb_seats != booking->nb_seats)
+            {
+                reportViolation(counters, client, operation, "annulation ne rendant pas la reservation", msg_resp);
+                break;
+            }
+            returned[booking->show] += nb_seats;
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Boucle d'un process client
+ */
+static void runClient(int client, unsigned long seed, long nb_operations,
+    StressCounters *counters, long *sold, long *returned)
+{
+    unsigned long random_state = seed * 2654435761UL + client + 1;
+    StressBooking bookings[MAX_CLIENT_BOOKINGS];
+    int nb_bookings = 0;
+    Request msg_req;
+    Response msg_resp;
+
+    for (long n = 0; n < nb_operations || nb_bookings > 0; n++)
+    {
+        int draw = nextRandom(&random_state) % 100;
+        int show = nextRandom(&random_state) % nb_shows;
+        int nb_seats = 1 + nextRandom(&random_state) % MAX_STRESS_SEATS;
+        StressBooking booking;
+        int request_type;
+
+        if (nb_bookings > 0 && (n >= nb_operations || nb_bookings == MAX_CLIENT_BOOKINGS
+            || draw < CANCEL_PERCENT))
+        {
+            // annulation d'une réservation du client (toutes en fin de test)
+            int k = nextRandom(&random_state) % nb_bookings;
+            booking = bookings[k];
+            bookings[k] = bookings[--nb_bookings];
+            request_type = REQUEST_CANCEL;
+            show = booking.show;
+        }
+        else
+        {
+            request_type = (nextRandom(&random_state) % 100 < CONSULT_PERCENT) ? REQUEST_CONSULT : REQUEST_RESA;
+        }
+
+        if (!sendRequest(request_type, show, (request_type == REQUEST_RESA) ? nb_seats : 0,
+            (request_type == REQUEST_CANCEL) ? booking.ticket : 0, &msg_req, &msg_resp))
+        {
+            perror("Serveur injoignable.\n");
+            counters->nb_violations++;
+            return;
+        }
+        if (msg_resp.status == STATUS_BUSY)
+        {
+            counters->nb_busy++;
+            if (request_type == REQUEST_CANCEL)
+            {
+                // réservation gardée pour une annulation ultérieure
+                bookings[nb_bookings++] = booking;
+            }
+            continue;
+        }
+        checkResponse(&msg_req, &msg_resp, show, &booking, counters, sold, returned,
+            bookings, &nb_bookings, client, n);
+    }
+}
+
+/**
+ * @brief Relève les places restantes de chaque spectacle
+ *
+ * @return bool : false si le serveur ne répond pas
+ */
+static bool readSeats(int *seats)
+{
+    Request msg_req;
+    Response msg_resp;
+
+    for (int show = 0; show < nb_shows; show++)
+    {
+        do
+        {
+            if (!sendRequest(REQUEST_CONSULT, show, 0, 0, &msg_req, &msg_resp))
+            {
+                return false;
+            }
+        } while (msg_resp.status == STATUS_BUSY);
+        seats[show] = msg_resp.msg.nb_seats;
+    }
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    int nb_clients = (argc > 1) ? atoi(argv[1]) : DEFAULT_NB_CLIENTS;
+    long nb_operations = (argc > 2) ? atol(argv[2]) : DEFAULT_NB_OPERATIONS;
+    unsigned long seed = (argc > 3) ? strtoul(argv[3], NULL, 10) : DEFAULT_SEED;
+
+    if (nb_clients < 1 || nb_operations < 1)
+    {
+        fprintf(stderr, "Utilisation : %s [nb_clients] [nb_operations] [graine]\n", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+    if ((queue_id = msgget(ftok(KEY_FILENAME, KEY_ID), 0666)) == -1)
+    {
+        perror("Serveur introuvable (file de messages).\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // capacités relevées au départ
+    for (nb_shows = 0; SHOW_IDS[nb_shows] != NULL; nb_shows++);
+    capacities = (int *)malloc(2 * nb_shows * sizeof(int));
+    if (capacities == NULL)
+    {
+        perror("Echec malloc.\n");
+        exit(EXIT_FAILURE);
+    }
+    int *remaining = capacities + nb_shows;
+    if (!readSeats(capacities))
+    {
+        perror("Serveur injoignable.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // compteurs des clients, partagés avec le père
+    size_t client_size = sizeof(StressCounters) + 2 * nb_shows * sizeof(long);
+    size_t size = nb_clients * client_size;
+    char *reports = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (reports == MAP_FAILED)
+    {
+        perror("Echec mmap.\n");
+        exit(EXIT_FAILURE);
+    }
+    printf("Graine %lu : %d clients, %ld operations chacun, %d spectacles.\n",
+        seed, nb_clients, nb_operations, nb_shows);
+    fflush(stdout);
+    for (int c = 0; c < nb_clients; c++)
+    {
+        pid_t pid = fork();
+        if (pid == -1)
+        {
+            perror("Echec fork.\n");
+            exit(EXIT_FAILURE);
+        }
+        if (pid == 0)
+        {
+            StressCounters *counters = (StressCounters *)(reports + c * client_size);
+            long *sold = (long *)(counters + 1);
+            runClient(c, seed, nb_operations, counters, sold, sold + nb_shows);
+            exit(EXIT_SUCCESS);
+        }
+    }
+    while (wait(NULL) > 0);
+
+    // bilan
+    StressCounters total;
+    memset(&total, 0, sizeof(total));
+    if (!readSeats(remaining))
+    {
+        perror("Serveur injoignable.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int show = 0; show < nb_shows; show++)
+    {
+        long sold = 0, returned = 0;
+        for (int c = 0; c < nb_clients; c++)
+        {
+            long *client_sold = (long *)((StressCounters *)(reports + c * client_size) + 1);
+            sold += client_sold[show];
+            returned += client_sold[nb_shows + show];
+        }
+        bool balanced = sold - returned + remaining[show] == capacities[show];
+        printf("%s : capacite %d, vendues %ld, rendues %ld, restantes %d%s\n", SHOW_IDS[show],
+            capacities[show], sold, returned, remaining[show],
+            balanced && remaining[show] == capacities[show] ? "" : " -> INVARIANT VIOLE");
+        if (!balanced || remaining[show] != capacities[show])
+        {
+            total.nb_violations++;
+        }
+    }
+    for (int c = 0; c < nb_clients; c++)
+    {
+        StressCounters *counters = (StressCounters *)(reports + c * client_size);
+        total.nb_booked += counters->nb_booked;
+        total.nb_refused += counters->nb_refused;
+        total.nb_cancelled += counters->nb_cancelled;
+        total.nb_consulted += counters->nb_consulted;
+        total.nb_busy += counters->nb_busy;
+        total.nb_violations += counters->nb_violations;
+    }
+    printf("Reservations %ld (refusees %ld), annulations %ld, consultations %ld, saturation %ld.\n",
+        total.nb_booked, total.nb_refused, total.nb_cancelled, total.nb_consulted, total.nb_busy);
+    printf("%s : %ld invariant(s) viole(s).\n", total.nb_violations == 0 ? "Succes" : "Echec",
+        total.nb_violations);
+    munmap(reports, size);
+    free(capacities);
+    return total.nb_violations == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,128 @@
+/*******************************************************************************
+ * @file ticket_table.c
+ * @brief Implémentation de la table indexée par ticket de la question 1.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * cf ticket_table.h
+ * ticket = (génération << TICKET_INDEX_BITS) | index de l'emplacement
+ * la génération n'est jamais nulle : un ticket valide vaut toujours au moins 1.
+ ******************************************************************************/
+
+#include "ticket_table.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#define TICKET_INDEX_MASK (MAX_TICKETS - 1)
+#define TICKET_MAX_GENERATION ((1U << (32 - TICKET_INDEX_BITS)) - 1)
+#define NO_TICKET 0xFFFFFFFFU // fin de la liste des emplacements libres
+
+/**
+ * @brief Renvoie l'emplacement d'index donné
+ */
+static TicketSlot *getSlot(TicketTable *table, unsigned int index)
+{
+    return (TicketSlot *)(table->chunks[index / TICKET_CHUNK_SIZE]
+        + (index % TICKET_CHUNK_SIZE) * table->item_size);
+}
+
+/**
+ * @brief Initialise une table vide (aucun bloc alloué)
+ *
+ * @param table la table à initialiser
+ * @param item_size la taille d'un élément, commençant par un TicketSlot
+ * @param max_items le nb maximal d'éléments (au plus MAX_TICKETS)
+ */
+void initTicketTable(TicketTable *table, size_t item_size, unsigned int max_items)
+{
+    memset(table, 0, sizeof(TicketTable));
+    table->item_size = item_size;
+    table->max_items = (max_items > MAX_TICKETS) ? MAX_TICKETS : max_items;
+    table->free_slots = NO_TICKET;
+}
+
+/**
+ * @brief Attribue un emplacement et un nouveau ticket
+ *
+ * @param table la table
+ * @return l'élément (ticket dans son en-tête), NULL si la table est pleine
+ */
+void *allocTicket(TicketTable *table)
+{
+    unsigned int index;
+    TicketSlot *slot;
+
+    if (table->free_slots != NO_TICKET)
+    {
+        // réutilisation d'un emplacement libéré
+        index = table->free_slots;
+        slot = getSlot(table, index);
+        table->free_slots = slot->next_free;
+    }
+    else
+    {
+        if (table->nb_slots == table->max_items)
+        {
+            return NULL;
+        }
+        index = table->nb_slots;
+        if (index % TICKET_CHUNK_SIZE == 0)
+        {
+            // nouveau bloc d'emplacements (mmap : pas de passage par le verrou de malloc)
+            char *chunk = (char *)mmap(NULL, TICKET_CHUNK_SIZE * table->item_size,
+                PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (chunk == MAP_FAILED)
+            {
+                return NULL;
+            }
+            table->chunks[index / TICKET_CHUNK_SIZE] = chunk;
+        }
+        table->nb_slots++;
+        slot = getSlot(table, index);
+        slot->generation = 0;
+    }
+    slot->generation = (slot->generation % TICKET_MAX_GENERATION) + 1;
+    slot->id = (slot->generation << TICKET_INDEX_BITS) | index;
+    table->nb_used++;
+    return slot;
+}
+
+/**
+ * @brief Rend un élément à la liste des emplacements libres
+ *
+ * Son ticket devient invalide.
+ *
+ * @param table la table
+ * @param item un élément attribué par allocTicket()
+ */
+void freeTicket(TicketTable *table, void *item)
+{
+    TicketSlot *slot = (TicketSlot *)item;
+
+    slot->next_free = table->free_slots;
+    table->free_slots = slot->id & TICKET_INDEX_MASK;
+    slot->id = 0;
+    table->nb_used--;
+}
+
+/**
+ * @brief Retrouve l'élément d'un ticket
+ *
+ * @param table la table
+ * @param id le ticket
+ * @return l'élément, NULL si le ticket est inconnu, périmé ou déjà libéré
+ */
+void *lookupTicket(TicketTable *table, unsigned int id)
+{
+    unsigned int index = id & TICKET_INDEX_MASK;
+
+    if (id == 0 || index >= table->nb_slots)
+    {
+        return NULL;
+    }
+    TicketSlot *slot = getSlot(table, index);
+    return (slot->id == id) ? slot : NULL;
+}
@@ -0,0 +1,52 @@
+/*******************************************************************************
+ * @file ticket_table.h
+ * @brief Table d'éléments indexée par ticket du serveur de la question 1.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * Utilisée pour les pré-réservations et les réservations :
+ * -> les éléments sont alloués par blocs de TICKET_CHUNK_SIZE, à la demande,
+ *    dans la limite de max_items (mémoire bornée)
+ * -> les emplacements libérés sont chainés entre eux et réutilisés en priorité
+ * -> un ticket contient l'index de l'emplacement et un numéro de génération :
+ *    allocation, libération et recherche par ticket en O(1), et un ticket périmé
+ *    ne désigne jamais l'élément suivant du même emplacement.
+ *
+ * Chaque élément commence par un en-tête TicketSlot.
+ *
+ * @note la table n'est pas protégée : l'appelant fournit l'exclusion mutuelle.
+ ******************************************************************************/
+
+#ifndef TICKET_TABLE_H
+#define TICKET_TABLE_H
+
+#include <stddef.h>
+
+#define TICKET_INDEX_BITS 22 // jusqu'à 4 millions d'éléments par table
+#define MAX_TICKETS (1U << TICKET_INDEX_BITS)
+#define TICKET_CHUNK_SIZE 4096
+
+// En-tête de chaque élément de la table
+typedef struct {
+    unsigned int id; // ticket courant, 0 si l'emplacement est libre
+    unsigned int generation; // dernière génération attribuée à l'emplacement
+    unsigned int next_free; // emplacement libre suivant
+} TicketSlot;
+
+typedef struct {
+    size_t item_size; // taille d'un élément (en-tête compris)
+    unsigned int max_items; // nb maximal d'éléments
+    unsigned int nb_slots; // nb d'emplacements déjà alloués
+    unsigned int free_slots; // tête de la liste des emplacements libres
+    unsigned int nb_used; // nb d'éléments attribués
+    char *chunks[MAX_TICKETS / TICKET_CHUNK_SIZE]; // blocs d'emplacements
+} TicketTable;
+
+//prototypes de fonctions
+void initTicketTable(TicketTable *table, size_t item_size, unsigned int max_items);
+void *allocTicket(TicketTable *table);
+void freeTicket(TicketTable *table, void *item);
+void *lookupTicket(TicketTable *table, unsigned int id);
+
+#endif
@@ -0,0 +1,183 @@
+/*******************************************************************************
+ * @file timer_wheel.c
+ * @brief Implémentation de la roue de temporisation hiérarchique de la question 1.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * cf timer_wheel.h
+ * Une entrée d'échéance e est rangée au plus petit niveau n tel que
+ * e - current < WHEEL_SLOTS ^ (n + 1), dans la case (e >> (n * WHEEL_BITS)) & WHEEL_MASK.
+ ******************************************************************************/
+
+#include "timer_wheel.h"
+
+#include <stddef.h>
+
+/**
+ * @brief Initialise une liste vide (sentinelle pointant sur elle-même)
+ *
+ * @param list la sentinelle de la liste
+ */
+void initTimerList(TimerEntry *list)
+{
+    list->next = list;
+    list->prev = list;
+}
+
+/**
+ * @brief Indique si une liste d'entrées est vide
+ *
+ * @param list la sentinelle de la liste
+ * @return true si la liste ne contient aucune entrée
+ */
+bool isTimerListEmpty(const TimerEntry *list)
+{
+    return list->next == list;
+}
+
+/**
+ * @brief Chaine une entrée en fin de liste
+ */
+static void appendTimer(TimerEntry *list, TimerEntry *entry)
+{
+    entry->prev = list->prev;
+    entry->next = list;
+    list->prev->next = entry;
+    list->prev = entry;
+}
+
+/**
+ * @brief Déplace toutes les entrées d'une liste en fin d'une autre (O(1))
+ */
+static void spliceTimers(TimerEntry *from, TimerEntry *to)
+{
+    if (isTimerListEmpty(from))
+    {
+        return;
+    }
+    from->next->prev = to->prev;
+    to->prev->next = from->next;
+    from->prev->next = to;
+    to->prev = from->prev;
+    initTimerList(from);
+}
+
+/**
+ * @brief Initialise une roue vide
+ *
+ * @param wheel la roue à initialiser
+ * @param now le tick courant
+ */
+void initTimerWheel(TimerWheel *wheel, unsigned long now)
+{
+    wheel->current = now;
+    for (int level = 0; level < WHEEL_LEVELS; level++)
+    {
+        for (int slot = 0; slot < WHEEL_SLOTS; slot++)
+        {
+            initTimerList(&wheel->slots[level][slot]);
+        }
+    }
+}
+
+/**
+ * @brief Arme une entrée pour l'échéance donnée (O(1))
+ *
+ * Une échéance déjà passée expire au prochain tick traité.
+ *
+ * @param wheel la roue
+ * @param entry l'entrée à armer (non armée)
+ * @param expires l'échéance en ticks
+ */
+void addTimer(TimerWheel *wheel, TimerEntry *entry, unsigned long expires)
+{
+    unsigned long delta;
+    int level = 0;
+
+    if ((long)(expires - wheel->current) < 0)
+    {
+        expires = wheel->current;
+    }
+    delta = expires - wheel->current;
+    // au delà de la portée de la roue, on ramène à l'échéance maximale
+    if (delta >= (1UL << (WHEEL_BITS * WHEEL_LEVELS)))
+    {
+        delta = (1UL << (WHEEL_BITS * WHEEL_LEVELS)) - 1;
+        expires = wheel->current + delta;
+    }
+    while (delta >= (1UL << (WHEEL_BITS * (level + 1))))
+    {
+        level++;
+    }
+    entry->expires = expires;
+    appendTimer(&wheel->slots[level][(expires >> (WHEEL_BITS * level)) & WHEEL_MASK], entry);
+}
+
+/**
+ * @brief Désarme une entrée (O(1))
+ *
+ * @param entry une entrée armée dans une roue ou chainée dans une liste d'expiration
+ */
+void cancelTimer(TimerEntry *entry)
+{
+    entry->prev->next = entry->next;
+    entry->next->prev = entry->prev;
+    entry->next = NULL;
+    entry->prev = NULL;
+}
+
+/**
+ * @brief Redistribue une case d'un niveau supérieur dans la roue
+ *
+ * @return l'index de la case redistribuée (0 : le niveau a fait un tour)
+ */
+static int cascadeTimers(TimerWheel *wheel, int level)
+{
+    int slot = (wheel->current >> (WHEEL_BITS * level)) & WHEEL_MASK;
+    TimerEntry pending;
+
+    initTimerList(&pending);
+    spliceTimers(&wheel->slots[level][slot], &pending);
+    while (!isTimerListEmpty(&pending))
+    {
+        TimerEntry *entry = pending.next;
+        cancelTimer(entry);
+        addTimer(wheel, entry, entry->expires);
+    }
+    return slot;
+}
+
+/**
+ * @brief Fait avancer la roue jusqu'au tick donné
+ *
+ * Les entrées échues sont toutes déplacées dans la liste expired,
+ * pour être traitées par lot par l'appelant.
+ *
+ * @param wheel la roue
+ * @param now le tick courant
+ * @param expired sentinelle d'une liste initialisée qui reçoit les entrées échues
+ * @return le nb de ticks traités
+ */
+int advanceTimerWheel(TimerWheel *wheel, unsigned long now, TimerEntry *expired)
+{
+    int nb_ticks = 0;
+
+    while ((long)(now - wheel->current) >= 0)
+    {
+        int slot = wheel->current & WHEEL_MASK;
+        // le niveau 0 a fait un tour : cascade des niveaux supérieurs
+        int level = 1;
+        if (slot == 0)
+        {
+            while (level < WHEEL_LEVELS && cascadeTimers(wheel, level) == 0)
+            {
+                level++;
+            }
+        }
+        spliceTimers(&wheel->slots[0][slot], expired);
+        wheel->current++;
+        nb_ticks++;
+    }
+    return nb_ticks;
+}
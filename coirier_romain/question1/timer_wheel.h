@@ -0,0 +1,51 @@
+/*******************************************************************************
+ * @file timer_wheel.h
+ * @brief Roue de temporisation hiérarchique du serveur de la question 1.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * WHEEL_LEVELS niveaux de WHEEL_SLOTS cases, chaque case étant une liste
+ * doublement chainée (sentinelle) d'entrées intrusives :
+ * -> insertion et annulation en O(1), sans parcours
+ * -> à chaque tick, la case courante du niveau 0 expire en bloc ;
+ *    quand elle fait le tour, la case correspondante du niveau supérieur
+ *    est redistribuée (cascade) vers les niveaux inférieurs.
+ *
+ * Portée : WHEEL_SLOTS ^ WHEEL_LEVELS ticks, les échéances plus lointaines sont ramenées
+ * à la portée maximale.
+ *
+ * @note la roue n'est pas protégée : l'appelant fournit l'exclusion mutuelle.
+ ******************************************************************************/
+
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <stdbool.h>
+
+#define WHEEL_BITS 6
+#define WHEEL_SLOTS (1 << WHEEL_BITS) // 64 cases par niveau
+#define WHEEL_MASK (WHEEL_SLOTS - 1)
+#define WHEEL_LEVELS 4 // 2^24 ticks de portée
+
+// Entrée de temporisation, à inclure dans la structure à temporiser
+typedef struct TimerEntry {
+    struct TimerEntry *next;
+    struct TimerEntry *prev;
+    unsigned long expires; // échéance en ticks
+} TimerEntry;
+
+typedef struct {
+    unsigned long current; // prochain tick à traiter
+    TimerEntry slots[WHEEL_LEVELS][WHEEL_SLOTS]; // sentinelles des listes
+} TimerWheel;
+
+//prototypes de fonctions
+void initTimerList(TimerEntry *list);
+bool isTimerListEmpty(const TimerEntry *list);
+void initTimerWheel(TimerWheel *wheel, unsigned long now);
+void addTimer(TimerWheel *wheel, TimerEntry *entry, unsigned long expires);
+void cancelTimer(TimerEntry *entry);
+int advanceTimerWheel(TimerWheel *wheel, unsigned long now, TimerEntry *expired);
+
+#endif
@@ -0,0 +1,160 @@
+/*******************************************************************************
+ * @file waitlist.c
+ * @brief Implémentation des listes d'attente du serveur de la question 1.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * cf waitlist.h
+ * Les demandes sont servies strictement dans l'ordre : tant que la première
+ * demande de la file ne peut pas être honorée, les suivantes attendent.
+ ******************************************************************************/
+
+#include "waitlist.h"
+#include "server.h"
+#include "bookings.h"
+
+#include <time.h>
+
+// File d'attente circulaire d'un spectacle
+typedef struct {
+    Waiter waiters[WAITLIST_CAPACITY];
+    int head; // index de la première demande
+    int count; // nb de demandes en attente
+} Waitlist;
+
+// variables du module
+static Waitlist *waitlists; // une file par spectacle
+
+/**
+ * @brief Alloue une file d'attente vide par spectacle
+ *
+ * @param nb_shows le nb de spectacles
+ */
+void initWaitlists(int nb_shows)
+{
+    waitlists = (Waitlist *)calloc(nb_shows, sizeof(Waitlist));
+}
+
+/**
+ * @brief Place une demande en fin de file (en section critique d'écriture)
+ *
+ * @param show_index l'index du spectacle dans shows[]
+ * @param pid le client à notifier
+ * @param nb_seats le nb de places demandées
+ * @return true si la demande est en attente, false si la file est pleine
+ */
+bool enqueueWaiter(int show_index, pid_t pid, signed char nb_seats)
+{
+    Waitlist *waitlist = &waitlists[show_index];
+
+    if (waitlist->count == WAITLIST_CAPACITY)
+    {
+        return false;
+    }
+    Waiter *waiter = &waitlist->waiters[(waitlist->head + waitlist->count) % WAITLIST_CAPACITY];
+    waiter->pid = pid;
+    waiter->nb_seats = nb_seats;
+    waitlist->count++;
+    return true;
+}
+
+/**
+ * @brief Indique si un client en attente existe encore
+ *
+ * @param pid le client
+ */
+static bool isClientAlive(pid_t pid)
+{
+    return kill(pid, 0) == 0 || errno != ESRCH;
+}
+
+/**
+ * @brief Sert les demandes en tête de file tant qu'il reste assez de places
+ * (en section critique d'écriture)
+ *
+ * Les places des demandes servies sont retirées de shows[].
+ * Les demandes des clients terminés sont retirées de la file sans être servies.
+ *
+ * @param show_index l'index du spectacle dans shows[]
+ * @param served reçoit les demandes servies (WAITLIST_MAX_SERVED au plus)
+ * @return le nb de demandes servies
+ */
+int serveWaiters(int show_index, Waiter *served)
+{
+    Waitlist *waitlist = &waitlists[show_index];
+    int nb_served = 0;
+
+    while (waitlist->count > 0
+        && waitlist->waiters[waitlist->head].nb_seats <= SHOW_SEATS(show_index))
+    {
+        Waiter *waiter = &waitlist->waiters[waitlist->head];
+        if (isClientAlive(waiter->pid))
+        {
+            served[nb_served] = *waiter;
+            SHOW_SEATS(show_index) -= served[nb_served].nb_seats;
+            nb_served++;
+        }
+        waitlist->head = (waitlist->head + 1) % WAITLIST_CAPACITY;
+        waitlist->count--;
+    }
+    return nb_served;
+}
+
+/**
+ * @brief Enregistre les réservations des demandes servies et notifie les clients
+ * (hors section critique)
+ *
+ * Tant que la file de messages est pleine, la notification est réessayée
+ * toutes les WAITLIST_RETRY_US ; elle n'est abandonnée que si le client s'est terminé.
+ * Les places qui n'ont pu être attribuées (table des réservations pleine, client terminé)
+ * ne sont pas rendues ici : l'appelant les rend (cf returnSeats()), sans récursion.
+ *
+ * @param show_index l'index du spectacle dans shows[]
+ * @param served les demandes servies par serveWaiters()
+ * @param nb_served leur nombre
+ * @return le nb de places à rendre au spectacle
+ */
+int notifyWaiters(int show_index, const Waiter *served, int nb_served)
+{
+    struct timespec retry_delay = {0, WAITLIST_RETRY_US * 1000L};
+    Response msg_resp;
+    int nb_returned = 0;
+
+    for (int i = 0; i < nb_served; i++)
+    {
+        msg_resp.msg_type = NOTIFY_TYPE(served[i].pid);
+        memcpy(msg_resp.msg.show_id, SHOW_ID(show_index), SHOW_ID_LEN);
+        msg_resp.msg.nb_seats = served[i].nb_seats;
+        msg_resp.status = STATUS_OK;
+        msg_resp.request_id = 0;
+        msg_resp.retry_after_ms = 0;
+        if ((msg_resp.ticket = recordBooking(show_index, served[i].nb_seats)) == 0)
+        {
+            // table des réservations pleine
+            nb_returned += served[i].nb_seats;
+            continue;
+        }
+        printf("Liste d'attente : reservation %u de %d places pour le spectacle %s (client %d).\n",
+            msg_resp.ticket, served[i].nb_seats, msg_resp.msg.show_id, served[i].pid);
+        // envoi sans attente : la file pleine est réessayée tant que le client existe
+        while (msgsnd(msg_queue_id, &msg_resp, sizeof(Response) - sizeof(long), IPC_NOWAIT) == -1)
+        {
+            if (errno != EAGAIN)
+            {
+                perror("Echec msgsnd (liste d'attente).\n");
+                exit(EXIT_FAILURE);
+            }
+            if (!isClientAlive(served[i].pid))
+            {
+                printf("Liste d'attente : client %d termine, reservation %u retiree.\n",
+                    served[i].pid, msg_resp.ticket);
+                removeBooking(msg_resp.ticket, &msg_resp.msg);
+                nb_returned += served[i].nb_seats;
+                break;
+            }
+            nanosleep(&retry_delay, NULL);
+        }
+    }
+    return nb_returned;
+}
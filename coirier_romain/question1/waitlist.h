@@ -0,0 +1,44 @@
+/*******************************************************************************
+ * @file waitlist.h
+ * @brief Listes d'attente par spectacle du serveur de la question 1.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * Une réservation refusée faute de places (requête REQUEST_WAITLIST) est placée
+ * dans la file d'attente (FIFO) du spectacle au lieu d'être simplement refusée.
+ * Dès que des places sont rendues (annulation, libération ou expiration d'une
+ * pré-réservation), les demandes en attente sont servies dans l'ordre d'arrivée :
+ * la réservation est enregistrée et sa confirmation est envoyée au client
+ * sur la file de messages, avec le type NOTIFY_TYPE(pid) (cf common.h).
+ *
+ * Une confirmation est réessayée tant que la file est pleine : elle n'est abandonnée
+ * (réservation retirée, places rendues) que si le client s'est terminé.
+ * Les demandes de clients terminés sont écartées sans être servies.
+ *
+ * @note les files sont des tampons circulaires de WAITLIST_CAPACITY demandes
+ * par spectacle, modifiés uniquement en section critique d'écriture sur shows[].
+ ******************************************************************************/
+
+#ifndef WAITLIST_H
+#define WAITLIST_H
+
+#include "common.h"
+
+#define WAITLIST_CAPACITY 64 // nb max de demandes en attente par spectacle
+#define WAITLIST_MAX_SERVED 128 // nb max de demandes servies en une fois (1 place minimum chacune)
+#define WAITLIST_RETRY_US 500 // attente entre deux envois d'une confirmation, file pleine
+
+// Demande en attente
+typedef struct {
+    pid_t pid; // client à notifier
+    signed char nb_seats; // nb de places demandées
+} Waiter;
+
+//prototypes de fonctions
+void initWaitlists(int nb_shows);
+bool enqueueWaiter(int show_index, pid_t pid, signed char nb_seats);
+int serveWaiters(int show_index, Waiter *served);
+int notifyWaiters(int show_index, const Waiter *served, int nb_served);
+
+#endif
@@ -0,0 +1,220 @@
+/*******************************************************************************
+ * @file admission.c
+ * @brief Implémentation du contrôle d'admission de la question 2.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * cf admission.h
+ * Seul le père admet des réservations (incrément du nb en cours), les fils
+ * ne font que le décrémenter : le test de la limite et l'incrément n'ont donc
+ * pas besoin d'être indivisibles. Les compteurs partagés sont modifiés
+ * par des opérations atomiques, sans prendre le sémaphore du tableau.
+ * La fiche d'une réservation admise est désignée par sa position (current_record),
+ * héritée par le fils au fork.
+ ******************************************************************************/
+
+#include "admission.h"
+#include "server.h"
+#include "shm_heap.h"
+
+#include <time.h>
+
+ServerStats *server_stats; // dans le segment partagé (cf attachGenerations())
+ShmSlab *reservation_slab; // dans le segment partagé (cf attachGenerations())
+
+// variables du module
+static int max_in_flight = DEFAULT_MAX_IN_FLIGHT;
+static ShmSlabCache record_cache; // fiches libres gardées par le père
+static ShmOffset current_record = SHM_NULL; // fiche de la dernière réservation admise
+static bool reservation_admitted = false; // réservation admise pas encore terminée (fils)
+
+/**
+ * @brief Date courante en ms (horloge monotone)
+ */
+static unsigned long currentMs()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000UL + now.tv_nsec / 1000000;
+}
+
+/**
+ * @brief Fixe la limite du nb de fils de réservation en cours
+ *
+ * @param max nb max de fils en cours (> 0)
+ */
+void initAdmission(int max)
+{
+    max_in_flight = max;
+    printf("%s : Controle d'admission : %d reservations en cours au maximum.\n",
+        process_name, max_in_flight);
+}
+
+/**
+ * @brief Mesure le nb de messages en attente dans la file
+ */
+static void sampleQueueDepth()
+{
+    struct msqid_ds queue_info;
+
+    if (msgctl(msg_queue_id, IPC_STAT, &queue_info) == -1)
+    {
+        return;
+    }
+    __atomic_store_n(&server_stats->queue_depth, queue_info.msg_qnum, __ATOMIC_RELAXED);
+    if (queue_info.msg_qnum > server_stats->max_queue_depth)
+    {
+        __atomic_store_n(&server_stats->max_queue_depth, queue_info.msg_qnum, __ATOMIC_RELAXED);
+    }
+}
+
+/**
+ * @brief Compte une consultation (serveur de consultation)
+ */
+void countConsultation()
+{
+    if (__atomic_add_fetch(&server_stats->nb_consultations, 1, __ATOMIC_RELAXED) % QUEUE_SAMPLE_PERIOD == 0)
+    {
+        sampleQueueDepth();
+    }
+}
+
+/**
+ * @brief Admet ou refuse une réservation reçue (père uniquement, avant le fork)
+ *
+ * Une réservation admise doit être terminée par releaseReservation() dans le fils
+ *
+ * @param msg_req la requête de réservation (pour sa fiche)
+ * @return bool : true si la réservation est admise, false si le serveur est saturé
+ */
+bool admitReservation(const Request *msg_req)
+{
+    if (__atomic_add_fetch(&server_stats->nb_reservations, 1, __ATOMIC_RELAXED) % QUEUE_SAMPLE_PERIOD == 0)
+    {
+        sampleQueueDepth();
+    }
+    int in_flight = __atomic_load_n(&server_stats->nb_in_flight, __ATOMIC_ACQUIRE);
+    if (in_flight >= max_in_flight)
+    {
+        __atomic_add_fetch(&server_stats->nb_rejected, 1, __ATOMIC_RELAXED);
+        sampleQueueDepth(); // pour le délai de réémission
+        return false;
+    }
+    in_flight = __atomic_add_fetch(&server_stats->nb_in_flight, 1, __ATOMIC_ACQ_REL);
+    if (in_flight > server_stats->peak_in_flight)
+    {
+        __atomic_store_n(&server_stats->peak_in_flight, in_flight, __ATOMIC_RELAXED);
+    }
+
+    // fiche de la réservation (aucune si toutes sont prises)
+    current_record = shmSlabAlloc(shows, reservation_slab, &record_cache);
+    ReservationRecord *record = (ReservationRecord *)shmPointer(shows, current_record);
+    if (record != NULL)
+    {
+        record->client_pid = msg_req->pid;
+        record->msg = msg_req->msg;
+        __atomic_store_n(&record->start_ms, currentMs(), __ATOMIC_RELEASE);
+    }
+    reservation_admitted = true; // hérité par le fils
+    return true;
+}
+
+/**
+ * @brief Fin de traitement d'une réservation admise (fils)
+ *
+ * Sans effet si elle est déjà terminée : le fils l'enregistre aussi avec atexit()
+ * pour être décompté même s'il s'arrête sur erreur (exit(EXIT_FAILURE)).
+ */
+void releaseReservation()
+{
+    ReservationRecord *record = (ReservationRecord *)shmPointer(shows, current_record);
+
+    if (!reservation_admitted)
+    {
+        return;
+    }
+    reservation_admitted = false;
+    if (record != NULL)
+    {
+        __atomic_store_n(&record->start_ms, 0, __ATOMIC_RELEASE);
+        shmSlabFree(shows, reservation_slab, NULL, current_record);
+        current_record = SHM_NULL;
+    }
+    __atomic_sub_fetch(&server_stats->nb_in_flight, 1, __ATOMIC_ACQ_REL);
+}
+
+/**
+ * @brief Rend à la réserve commune les fiches gardées par le père
+ *
+ * Avant l'arrêt d'un père qui laisse le segment à un autre serveur (cf handover.h).
+ */
+void releaseRecordCache()
+{
+    while (record_cache.count > 0)
+    {
+        unsigned int index = record_cache.indexes[--record_cache.count];
+        shmSlabFree(shows, reservation_slab, NULL,
+            reservation_slab->objects + (size_t)(index - 1) * reservation_slab->object_size);
+    }
+}
+
+/**
+ * @brief Délai de réémission conseillé à un client refusé
+ *
+ * BUSY_RETRY_MS, augmenté d'autant pour chaque "limite" de messages en attente
+ *
+ * @return int : le délai en ms
+ */
+int getRetryAfterMs()
+{
+    unsigned long depth = __atomic_load_n(&server_stats->queue_depth, __ATOMIC_RELAXED);
+    return BUSY_RETRY_MS * (1 + (int)(depth / max_in_flight));
+}
+
+/**
+ * @brief Affiche les compteurs du serveur
+ */
+void printServerStats()
+{
+    printf("===== %s : statistiques =====\n", process_name);
+    printf("Requetes : %lu consultations, %lu reservations dont %lu refusees (serveur sature).\n",
+        __atomic_load_n(&server_stats->nb_consultations, __ATOMIC_RELAXED),
+        __atomic_load_n(&server_stats->nb_reservations, __ATOMIC_RELAXED),
+        __atomic_load_n(&server_stats->nb_rejected, __ATOMIC_RELAXED));
+    printf("Reservations en cours : %d (pic %d, limite %d).\n",
+        __atomic_load_n(&server_stats->nb_in_flight, __ATOMIC_RELAXED),
+        __atomic_load_n(&server_stats->peak_in_flight, __ATOMIC_RELAXED), max_in_flight);
+    printf("File de messages : %lu messages en attente (max mesure %lu).\n",
+        __atomic_load_n(&server_stats->queue_depth, __ATOMIC_RELAXED),
+        __atomic_load_n(&server_stats->max_queue_depth, __ATOMIC_RELAXED));
+
+    // plus ancienne réservation en cours, d'après les fiches
+    ReservationRecord oldest = {0};
+    unsigned int nb_records = 0;
+    for (unsigned int i = 0; i < reservation_slab->nb_objects; i++)
+    {
+        ReservationRecord *record = (ReservationRecord *)((char *)shows + reservation_slab->objects
+            + (size_t)i * reservation_slab->object_size);
+        unsigned long start_ms = __atomic_load_n(&record->start_ms, __ATOMIC_ACQUIRE);
+        if (start_ms != 0)
+        {
+            nb_records++;
+        }
+        if (start_ms != 0 && (oldest.start_ms == 0 || start_ms < oldest.start_ms))
+        {
+            oldest = *record;
+            oldest.start_ms = start_ms;
+        }
+    }
+    printf("Fiches de reservation : %u en cours, %u hors reserve commune, sur %u.\n",
+        nb_records, __atomic_load_n(&reservation_slab->nb_used, __ATOMIC_RELAXED),
+        reservation_slab->nb_objects);
+    if (oldest.start_ms != 0)
+    {
+        printf("Plus ancienne reservation en cours : %d places pour %s (client %d) depuis %lu ms.\n",
+            oldest.msg.nb_seats, oldest.msg.show_id, oldest.client_pid, currentMs() - oldest.start_ms);
+    }
+    printLockProfile();
+    printShmHeapStats();
+}
@@ -0,0 +1,76 @@
+/*******************************************************************************
+ * @file admission.h
+ * @brief Contrôle d'admission et statistiques du serveur de la question 2.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * Le serveur de réservation crée un process fils par requête : le nb de fils
+ * en cours est borné (option -m du serveur, DEFAULT_MAX_IN_FLIGHT par défaut).
+ * Au delà, la requête est refusée sans fork par une réponse STATUS_BUSY
+ * indiquant au client un délai avant réémission (retry_after_ms), d'autant plus
+ * long que la file de messages est chargée.
+ *
+ * Les compteurs sont dans le segment partagé, après le journal de réplication,
+ * pour être tenus par le père (admission), les fils (fin de traitement)
+ * et le serveur de consultation. Ils sont affichés sur SIGUSR1 :
+ * $ kill -USR1 <pid du serveur de consultation ou de réservation>
+ *
+ * Chaque réservation en cours a une fiche (client, spectacle, début) allouée
+ * par le père dans une réserve du segment (cf shm_slab.h) et libérée par le fils :
+ * l'affichage indique la plus ancienne réservation en cours.
+ *
+ * Un fils terminé sur erreur (exit(EXIT_FAILURE)) est décompté et sa fiche
+ * libérée par releaseReservation(), enregistrée avec atexit() après le fork.
+ *
+ * @note un fils tué par un signal n'est pas décompté.
+ ******************************************************************************/
+
+#ifndef ADMISSION_H
+#define ADMISSION_H
+
+#include "common.h"
+#include "shm_slab.h"
+#include "lock_profile.h"
+
+#define DEFAULT_MAX_IN_FLIGHT 64 // nb max de fils de réservation en cours
+#define BUSY_RETRY_MS 50 // délai de réémission conseillé, file vide
+#define QUEUE_SAMPLE_PERIOD 16 // mesure de la profondeur de la file toutes les N requêtes
+#define RESERVATION_RECORDS 1024 // nb de fiches de réservation en cours (dans le segment)
+
+// Compteurs du serveur (dans le segment partagé)
+typedef struct {
+    unsigned long nb_consultations;
+    unsigned long nb_reservations; // réservations reçues (admises ou non)
+    unsigned long nb_rejected; // réservations refusées (serveur saturé)
+    int nb_in_flight; // fils de réservation en cours
+    int peak_in_flight;
+    unsigned long queue_depth; // dernière profondeur mesurée de la file
+    unsigned long max_queue_depth;
+    LockCounters locks[LOCK_NB_SITES]; // profil d'attente des sémaphores (cf lock_profile.h)
+    pid_t server_pid; // père du serveur en service (cf handover.h)
+    pid_t draining_pid; // père d'un ancien serveur qui termine ses requêtes
+    pid_t feed_pid; // émetteur de réplication (cf replication.h)
+} ServerStats;
+
+// Fiche d'une réservation en cours (dans le segment)
+// (le début d'une fiche libre sert au chaînage de la réserve)
+typedef struct {
+    pid_t client_pid;
+    Message msg; // la demande
+    unsigned long start_ms; // début du traitement (0 : fiche libre)
+} ReservationRecord;
+
+extern ServerStats *server_stats;
+extern ShmSlab *reservation_slab;
+
+//prototypes de fonctions
+void initAdmission(int max_in_flight);
+void countConsultation();
+bool admitReservation(const Request *msg_req);
+void releaseReservation();
+void releaseRecordCache();
+int getRetryAfterMs();
+void printServerStats();
+
+#endif
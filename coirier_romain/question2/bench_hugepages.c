@@ -0,0 +1,211 @@
+/*******************************************************************************
+ * @file bench_hugepages.c
+ * @brief Recherches au hasard dans un grand catalogue, pages normales / grandes pages (question 2).
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * Un segment partagé contient, comme celui du serveur lancé avec -c, un tableau
+ * de nb_spectacles spectacles suivi de son index (cf show_lookup.h). Chaque
+ * recherche tire un spectacle au hasard dans tout le catalogue, le retrouve par
+ * l'index puis lit ses places : deux accès à des pages différentes par recherche.
+ * -> 4k : segment en pages normales (grandes pages transparentes refusées)
+ * -> huge : segment créé comme avec l'option -H du serveur (cf huge_pages.h)
+ * Sont affichés la taille des pages obtenues, le temps par recherche et,
+ * si le noyau les expose (perf_event_open), les défauts de TLB données.
+ *
+ * Compilation :
+ * $ gcc -O2 -o bench_hugepages bench_hugepages.c huge_pages.c show_lookup.c
+ * Utilisation : ./bench_hugepages 4k|huge [nb_spectacles] [nb_recherches]
+ *
+ * @note le mode huge n'obtient de grandes pages qu'avec des grandes pages
+ * réservées (sysctl vm.nr_hugepages=N) ou les grandes pages transparentes
+ * du segment partagé (/sys/kernel/mm/transparent_hugepage/shmem_enabled).
+ ******************************************************************************/
+
+#include "huge_pages.h"
+#include "show_lookup.h"
+
+#include <sys/shm.h>
+#include <sys/mman.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include <time.h>
+
+#define DEFAULT_NB_SHOWS 4000000
+#define DEFAULT_NB_LOOKUPS 20000000L
+
+/**
+ * @brief Identifiant généré du j-ième spectacle (comme le serveur avec -c)
+ */
+static void makeShowId(int j, char show_id[SHOW_ID_LEN])
+{
+    static const char digits[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+    show_id[0] = 'C';
+    for (int k = SHOW_ID_LEN - 2; k > 0; k--)
+    {
+        show_id[k] = digits[j % 36];
+        j /= 36;
+    }
+    show_id[SHOW_ID_LEN - 1] = '\0';
+}
+
+/**
+ * @brief Ouvre le compteur des défauts de TLB données du process
+ *
+ * @return int : le descripteur, -1 si le noyau ne l'expose pas
+ */
+static int openTlbCounter()
+{
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+        | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+/**
+ * @brief Taille des pages de la projection contenant address (d'après /proc/self/smaps)
+ *
+ * @param thp_kb reçoit la part en grandes pages transparentes (Ko)
+ * @return long : la taille des pages en Ko, 0 si inconnue
+ */
+static long getPageSizeKb(void *address, long *thp_kb)
+{
+    FILE *smaps = fopen("/proc/self/smaps", "r");
+    char line[256];
+    bool in_mapping = false;
+    long page_kb = 0;
+
+    *thp_kb = 0;
+    if (smaps == NULL)
+    {
+        return 0;
+    }
+    while (fgets(line, sizeof(line), smaps) != NULL)
+    {
+        unsigned long start, end;
+        if (sscanf(line, "%lx-%lx ", &start, &end) == 2 && strchr(line, ':') != NULL
+            && strchr(line, '-') < strchr(line, ' '))
+        {
+            in_mapping = (unsigned long)address >= start && (unsigned long)address < end;
+        }
+        else if (in_mapping)
+        {
+            sscanf(line, "KernelPageSize: %ld kB", &page_kb);
+            sscanf(line, "ShmemPmdMapped: %ld kB", thp_kb);
+        }
+    }
+    fclose(smaps);
+    return page_kb;
+}
+
+int main(int argc, char *argv[])
+{
+    bool huge = (argc > 1) && strcmp(argv[1], "huge") == 0;
+    int nb_shows = (argc > 2) ? atoi(argv[2]) : DEFAULT_NB_SHOWS;
+    long nb_lookups = (argc > 3) ? atol(argv[3]) : DEFAULT_NB_LOOKUPS;
+    struct timespec start, end;
+    long long tlb_misses = -1;
+    int counter;
+    int counter_errno;
+
+    if (argc < 2 || nb_shows < 1 || nb_lookups < 1)
+    {
+        fprintf(stderr, "Utilisation : %s 4k|huge [nb_spectacles] [nb_recherches]\n", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+    // segment : tableau des spectacles puis index
+    size_t size = nb_shows * sizeof(Message) + getShowIndexSize(nb_shows);
+    int id = createHugeSegment(IPC_PRIVATE, size, huge);
+    if (id == -1)
+    {
+        perror("Echec shmget.\n");
+        exit(EXIT_FAILURE);
+    }
+    Message *shows = (Message *)shmat(id, NULL, 0);
+    shmctl(id, IPC_RMID, NULL); // supprimé au détachement
+    if (shows == (Message *)-1)
+    {
+        perror("Erreur lors de l attachement a la memoire partagee");
+        exit(EXIT_FAILURE);
+    }
+    if (huge)
+    {
+        adviseHugePages(shows, size);
+    }
+#ifdef MADV_NOHUGEPAGE
+    else
+    {
+        madvise(shows, size, MADV_NOHUGEPAGE);
+    }
+#endif
+    ShowIndex *index = (ShowIndex *)(shows + nb_shows);
+    for (int i = 0; i < nb_shows; i++)
+    {
+        makeShowId(i, shows[i].show_id);
+        shows[i].nb_seats = 16 + i % 15;
+    }
+    fillShowIndex(index, shows, nb_shows);
+
+    counter = openTlbCounter();
+    counter_errno = errno;
+    if (counter != -1)
+    {
+        ioctl(counter, PERF_EVENT_IOC_RESET, 0);
+        ioctl(counter, PERF_EVENT_IOC_ENABLE, 0);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    long total_seats = 0;
+    unsigned long random_state = 103;
+    char show_id[SHOW_ID_LEN];
+    for (long n = 0; n < nb_lookups; n++)
+    {
+        // spectacle tiré au hasard dans tout le catalogue (xorshift)
+        random_state ^= random_state << 13;
+        random_state ^= random_state >> 7;
+        random_state ^= random_state << 17;
+        makeShowId((int)(random_state % nb_shows), show_id);
+        ShowKey key = makeShowKey(show_id);
+        int i;
+        lookupShows(index, &key, 1, &i);
+        total_seats += shows[i].nb_seats;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    if (counter != -1)
+    {
+        ioctl(counter, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(counter, &tlb_misses, sizeof(tlb_misses)) != sizeof(tlb_misses))
+        {
+            tlb_misses = -1;
+        }
+        close(counter);
+    }
+
+    long thp_kb;
+    long page_kb = getPageSizeKb(shows, &thp_kb);
+    double elapsed_ns = (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+    printf("Mode %s : segment de %zu Mo, pages de %ld Ko (%ld Ko en grandes pages transparentes)\n",
+        huge ? "huge" : "4k", size >> 20, page_kb, thp_kb);
+    printf("%d spectacles, %ld recherches : %.1f ns par recherche", nb_shows, nb_lookups,
+        elapsed_ns / nb_lookups);
+    if (tlb_misses >= 0)
+    {
+        printf(", %.3f defauts de TLB par recherche\n", (double)tlb_misses / nb_lookups);
+    }
+    else
+    {
+        printf(", defauts de TLB non mesurables (perf_event_open : %s)\n", strerror(counter_errno));
+    }
+    printf("(controle : %ld places)\n", total_seats);
+    shmdt(shows);
+    return 0;
+}
@@ -0,0 +1,139 @@
+/*******************************************************************************
+ * @file bench_lookup.c
+ * @brief Comparaison des noyaux de recherche des spectacles et des tailles de lot (question 2).
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * Un index (cf show_lookup.h) de nb_spectacles spectacles générés est interrogé
+ * avec des identifiants tirés au hasard (dont 1 sur 8 inconnu), par lots de
+ * 1, 4, 16 et 64, avec chaque noyau disponible. Pour un petit catalogue, le
+ * parcours du tableau par strcmp() (ancienne recherche du serveur) sert de référence.
+ *
+ * Compilation :
+ * $ gcc -O2 -o bench_lookup bench_lookup.c show_lookup.c
+ * Utilisation : ./bench_lookup [nb_spectacles] [nb_recherches]
+ ******************************************************************************/
+
+#include "show_lookup.h"
+
+#include <time.h>
+
+#define DEFAULT_NB_SHOWS 100000
+#define DEFAULT_NB_LOOKUPS 10000000L
+#define NB_RANDOM_KEYS 65536 // clés tirées à l'avance (puissance de 2)
+#define MAX_STRCMP_SHOWS 10000 // au delà, pas de mesure de référence
+
+/**
+ * @brief Identifiant généré du j-ième spectacle (comme le serveur avec -c)
+ */
+static void makeShowId(int j, char show_id[SHOW_ID_LEN])
+{
+    static const char digits[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+    show_id[0] = 'C';
+    for (int k = SHOW_ID_LEN - 2; k > 0; k--)
+    {
+        show_id[k] = digits[j % 36];
+        j /= 36;
+    }
+    show_id[SHOW_ID_LEN - 1] = '\0';
+}
+
+/**
+ * @brief Durée écoulée depuis start, en ns
+ */
+static double elapsedNs(const struct timespec *start)
+{
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (end.tv_sec - start->tv_sec) * 1e9 + (end.tv_nsec - start->tv_nsec);
+}
+
+int main(int argc, char *argv[])
+{
+    static const char *const kernels[] = {"scalaire", "sse4.2", "avx2"};
+    static const int batch_sizes[] = {1, 4, 16, SHOW_LOOKUP_BATCH};
+    int nb_shows = (argc > 1) ? atoi(argv[1]) : DEFAULT_NB_SHOWS;
+    long nb_lookups = (argc > 2) ? atol(argv[2]) : DEFAULT_NB_LOOKUPS;
+    struct timespec start;
+    int indexes[SHOW_LOOKUP_BATCH];
+    long found = 0;
+
+    if (nb_shows < 1 || nb_lookups < SHOW_LOOKUP_BATCH)
+    {
+        fprintf(stderr, "Utilisation : %s [nb_spectacles] [nb_recherches >= %d]\n", argv[0], SHOW_LOOKUP_BATCH);
+        exit(EXIT_FAILURE);
+    }
+
+    // catalogue et index
+    Message *shows = (Message *)calloc(nb_shows, sizeof(Message));
+    ShowIndex *index = (ShowIndex *)malloc(getShowIndexSize(nb_shows));
+    ShowKey *keys = (ShowKey *)malloc(NB_RANDOM_KEYS * sizeof(ShowKey));
+    char (*ids)[SHOW_ID_LEN] = malloc(NB_RANDOM_KEYS * SHOW_ID_LEN);
+    if (shows == NULL || index == NULL || keys == NULL || ids == NULL)
+    {
+        perror("Echec malloc.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < nb_shows; i++)
+    {
+        makeShowId(i, shows[i].show_id);
+    }
+    fillShowIndex(index, shows, nb_shows);
+    srand(103);
+    for (int i = 0; i < NB_RANDOM_KEYS; i++)
+    {
+        // 1 sur 8 hors catalogue
+        makeShowId((i % 8 == 0) ? nb_shows + rand() % 1000 : rand() % nb_shows, ids[i]);
+        keys[i] = makeShowKey(ids[i]);
+    }
+
+    printf("%d spectacles, %ld recherches (ns par identifiant) :\n", nb_shows, nb_lookups);
+    if (nb_shows <= MAX_STRCMP_SHOWS)
+    {
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (long n = 0; n < nb_lookups; n++)
+        {
+            const char *show_id = ids[n & (NB_RANDOM_KEYS - 1)];
+            for (int i = 0; i < nb_shows; i++)
+            {
+                if (strcmp(show_id, shows[i].show_id) == 0)
+                {
+                    found++;
+                    break;
+                }
+            }
+        }
+        printf("  strcmp    : %8.1f\n", elapsedNs(&start) / nb_lookups);
+    }
+    for (int k = 0; k < 3; k++)
+    {
+        if (strcmp(selectLookupKernel(kernels[k]), kernels[k]) != 0)
+        {
+            printf("  %-9s : non disponible\n", kernels[k]);
+            continue;
+        }
+        printf("  %-9s :", kernels[k]);
+        for (int b = 0; b < 4; b++)
+        {
+            int batch = batch_sizes[b];
+            long nb_batches = nb_lookups / batch;
+
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            for (long n = 0; n < nb_batches; n++)
+            {
+                lookupShows(index, &keys[(n * batch) & (NB_RANDOM_KEYS - 1)], batch, indexes);
+                found += indexes[0] >= 0;
+            }
+            printf(" %8.1f (lot de %d)", elapsedNs(&start) / (nb_batches * batch), batch);
+        }
+        printf("\n");
+    }
+    printf("(controle : %ld)\n", found);
+    free(ids);
+    free(keys);
+    free(index);
+    free(shows);
+    return 0;
+}
@@ -0,0 +1,264 @@
+/*******************************************************************************
+ * @file bench_numa.c
+ * @brief Recherches dans un catalogue partagé, avec ou sans placement NUMA (question 2).
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * Un segment partagé contient, comme celui du serveur lancé avec -c, un tableau
+ * de nb_spectacles spectacles suivi de son index (cf show_lookup.h). nb_process
+ * process (comme les process du serveur) y cherchent chacun des spectacles tirés
+ * au hasard et lisent leurs places :
+ * -> unbound : ni affinité CPU ni politique mémoire (serveur lancé sans -p)
+ * -> local : process épinglés sur le noeud 0, segment alloué sur le noeud 0
+ *    (serveur lancé avec -p, cf numa_placement.h)
+ * -> remote : process épinglés sur le noeud 0, segment alloué sur le dernier noeud
+ *    (accès d'un socket à l'autre, le cas que -p évite)
+ * Sont affichés la répartition des pages du segment par noeud (move_pages)
+ * et le temps par recherche.
+ *
+ * Compilation :
+ * $ gcc -O2 -o bench_numa bench_numa.c numa_placement.c show_lookup.c
+ * Utilisation : ./bench_numa unbound|local|remote [nb_spectacles] [nb_recherches] [nb_process]
+ *
+ * @note sur une machine à un seul noeud NUMA, remote équivaut à local et les
+ * 3 modes ne diffèrent que par l'affinité CPU : la comparaison n'a de sens
+ * que sur une machine à plusieurs sockets.
+ ******************************************************************************/
+
+#include "numa_placement.h"
+#include "show_lookup.h"
+
+#include <sys/shm.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <sys/syscall.h>
+#include <time.h>
+
+#define DEFAULT_NB_SHOWS 4000000
+#define DEFAULT_NB_LOOKUPS 20000000L
+#define DEFAULT_NB_PROCESSES 4
+#define MAX_SAMPLED_PAGES 4096 // pages du segment dont le noeud est relevé
+#define MAX_REPORTED_NODES 64
+
+/**
+ * @brief Identifiant généré du j-ième spectacle (comme le serveur avec -c)
+ */
+static void makeShowId(int j, char show_id[SHOW_ID_LEN])
+{
+    static const char digits[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+    show_id[0] = 'C';
+    for (int k = SHOW_ID_LEN - 2; k > 0; k--)
+    {
+        show_id[k] = digits[j % 36];
+        j /= 36;
+    }
+    show_id[SHOW_ID_LEN - 1] = '\0';
+}
+
+/**
+ * @brief Affiche la répartition par noeud d'un échantillon des pages d'une zone
+ *
+ * move_pages sans noeud cible ne déplace rien : il renvoie le noeud de chaque page.
+ */
+static void printPagePlacement(void *addr, size_t size)
+{
+    long page_size = sysconf(_SC_PAGESIZE);
+    long nb_pages = (size + page_size - 1) / page_size;
+    int nb_sampled = (nb_pages < MAX_SAMPLED_PAGES) ? (int)nb_pages : MAX_SAMPLED_PAGES;
+    void *pages[MAX_SAMPLED_PAGES];
+    int status[MAX_SAMPLED_PAGES];
+    int per_node[MAX_REPORTED_NODES] = {0};
+    int nb_unknown = 0;
+
+    for (int k = 0; k < nb_sampled; k++)
+    {
+        pages[k] = (char *)addr + (nb_pages * k / nb_sampled) * page_size;
+    }
+    if (syscall(SYS_move_pages, 0, nb_sampled, pages, NULL, status, 0) == -1)
+    {
+        printf("Repartition des pages inconnue (move_pages : %s)\n", strerror(errno));
+        return;
+    }
+    for (int k = 0; k < nb_sampled; k++)
+    {
+        if (status[k] >= 0 && status[k] < MAX_REPORTED_NODES)
+        {
+            per_node[status[k]]++;
+        }
+        else
+        {
+            nb_unknown++;
+        }
+    }
+    printf("Pages du segment (%d relevees) :", nb_sampled);
+    for (int node = 0; node < MAX_REPORTED_NODES; node++)
+    {
+        if (per_node[node] > 0)
+        {
+            printf(" noeud %d %.0f%%", node, 100.0 * per_node[node] / nb_sampled);
+        }
+    }
+    if (nb_unknown > 0)
+    {
+        printf(" inconnu %.0f%%", 100.0 * nb_unknown / nb_sampled);
+    }
+    printf("\n");
+}
+
+/**
+ * @brief Recherches d'un process : spectacles tirés au hasard dans tout le catalogue
+ *
+ * @return long : le total des places lues (contrôle)
+ */
+static long runLookups(const Message *shows, const ShowIndex *index, int nb_shows,
+    long nb_lookups, unsigned long seed)
+{
+    unsigned long random_state = seed * 2654435761UL + 1;
+    char show_id[SHOW_ID_LEN];
+    long total_seats = 0;
+
+    for (long n = 0; n < nb_lookups; n++)
+    {
+        // xorshift
+        random_state ^= random_state << 13;
+        random_state ^= random_state >> 7;
+        random_state ^= random_state << 17;
+        makeShowId((int)(random_state % nb_shows), show_id);
+        ShowKey key = makeShowKey(show_id);
+        int i;
+        lookupShows(index, &key, 1, &i);
+        total_seats += shows[i].nb_seats;
+    }
+    return total_seats;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *mode = (argc > 1) ? argv[1] : "";
+    int nb_shows = (argc > 2) ? atoi(argv[2]) : DEFAULT_NB_SHOWS;
+    long nb_lookups = (argc > 3) ? atol(argv[3]) : DEFAULT_NB_LOOKUPS;
+    int nb_processes = (argc > 4) ? atoi(argv[4]) : DEFAULT_NB_PROCESSES;
+    int nb_nodes = getNbNumaNodes();
+    int memory_node = -1; // noeud du segment (-1 : pas de politique mémoire)
+    struct timespec start, end;
+
+    if (strcmp(mode, "local") == 0)
+    {
+        memory_node = 0;
+    }
+    else if (strcmp(mode, "remote") == 0)
+    {
+        memory_node = nb_nodes - 1;
+    }
+    else if (strcmp(mode, "unbound") != 0)
+    {
+        nb_shows = 0; // utilisation affichée ci-dessous
+    }
+    if (nb_shows < 1 || nb_lookups < 1 || nb_processes < 1)
+    {
+        fprintf(stderr, "Utilisation : %s unbound|local|remote [nb_spectacles] [nb_recherches] [nb_process]\n", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+    printf("%d noeud(s) NUMA, mode %s", nb_nodes, mode);
+    if (memory_node >= 0)
+    {
+        printf(" : process sur le noeud 0, segment sur le noeud %d", memory_node);
+    }
+    printf("\n");
+
+    // process épinglés avant le remplissage et les fork (affinité héritée)
+    if (memory_node >= 0 && !pinToNumaNode(0))
+    {
+        printf("Affinite CPU non posee : process non epingles.\n");
+    }
+
+    // segment : tableau des spectacles puis index
+    size_t size = nb_shows * sizeof(Message) + getShowIndexSize(nb_shows);
+    int id = shmget(IPC_PRIVATE, size, IPC_CREAT | 0600);
+    if (id == -1)
+    {
+        perror("Echec shmget.\n");
+        exit(EXIT_FAILURE);
+    }
+    Message *shows = (Message *)shmat(id, NULL, 0);
+    shmctl(id, IPC_RMID, NULL); // supprimé au détachement
+    if (shows == (Message *)-1)
+    {
+        perror("Erreur lors de l attachement a la memoire partagee");
+        exit(EXIT_FAILURE);
+    }
+    // allocation sur le noeud demandé, avant le premier accès (comme le serveur)
+    if (memory_node >= 0 && !bindToNumaNode(shows, size, memory_node))
+    {
+        printf("Politique memoire non posee : segment alloue au premier acces.\n");
+    }
+    ShowIndex *index = (ShowIndex *)(shows + nb_shows);
+    for (int i = 0; i < nb_shows; i++)
+    {
+        makeShowId(i, shows[i].show_id);
+        shows[i].nb_seats = 16 + i % 15;
+    }
+    fillShowIndex(index, shows, nb_shows);
+    printPagePlacement(shows, size);
+
+    // places lues par chaque process (contrôle), partagées avec le père
+    long *seats_read = mmap(NULL, nb_processes * sizeof(long), PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (seats_read == MAP_FAILED)
+    {
+        perror("Echec mmap.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // départ simultané des process : fermeture du tube par le père
+    int start_pipe[2];
+    if (pipe(start_pipe) == -1)
+    {
+        perror("Echec pipe.\n");
+        exit(EXIT_FAILURE);
+    }
+    fflush(stdout);
+    long nb_per_process = nb_lookups / nb_processes;
+    for (int p = 0; p < nb_processes; p++)
+    {
+        pid_t pid = fork();
+        if (pid == -1)
+        {
+            perror("Echec fork.\n");
+            exit(EXIT_FAILURE);
+        }
+        if (pid == 0)
+        {
+            char byte;
+            close(start_pipe[1]);
+            if (read(start_pipe[0], &byte, 1) == -1)
+            {
+                exit(EXIT_FAILURE);
+            }
+            seats_read[p] = runLookups(shows, index, nb_shows, nb_per_process, 103 + p);
+            exit(EXIT_SUCCESS);
+        }
+    }
+    close(start_pipe[0]);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    close(start_pipe[1]);
+    while (wait(NULL) > 0);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    long total_seats = 0;
+    for (int p = 0; p < nb_processes; p++)
+    {
+        total_seats += seats_read[p];
+    }
+    double elapsed_ns = (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+    long nb_done = nb_per_process * nb_processes;
+    printf("%d spectacles (segment de %zu Mo), %d process, %ld recherches : %.1f ns par recherche"
+        " (%.0f recherches/s)\n", nb_shows, size >> 20, nb_processes, nb_done,
+        elapsed_ns * nb_processes / nb_done, nb_done / (elapsed_ns / 1e9));
+    printf("(controle : %ld places)\n", total_seats);
+    munmap(seats_read, nb_processes * sizeof(long));
+    shmdt(shows);
+    return 0;
+}
@@ -12,20 +12,29 @@
  * 
  * @note Ce client permet de faire de multiples requêtes à la suite 
  * 
+ * Option -l : mode lecture locale, les consultations sont lues directement
+ * dans le segment partagé du serveur (cf client_lib.h), seules les réservations
+ * passent par la file de messages.
+ * Option -n NB : déploiement en NB partitions, chaque requête est routée
+ * vers le serveur propriétaire du spectacle (cf client_lib.h).
+ * Une requête refusée par un serveur saturé (STATUS_BUSY) est réémise
+ * après le délai indiqué, au plus MAX_BUSY_RETRIES fois.
+ * 
  * @bug ?
  ******************************************************************************/
 
 #include "common.h"
+#include "client_lib.h"
+
+#include <getopt.h>
 
-//Variables globales
-int msg_queue_id; // l'identifiant de la file de messages System V
+#define MAX_BUSY_RETRIES 5 // nb de réémissions d'une requête refusée (serveur saturé)
 
 //prototypes de fonctions
 void sigint_handler(int sig);
 
 void setupSignalHandlers();
-void setupMsgQueue(key_t key);
-void initClient();
+void initClient(int nb_shards);
 
 int getUserRequest(Message *msg);
 void requestShowId(Message *msg);
@@ -40,8 +49,10 @@ void displayResponse(Response msg_resp, Request msg_req);
  * Crée ou récupère une message queue pour envoyer et recevoir des messages
  * avec un server sur la meme machine locale.
  * 
+ * @param argv "-l" pour répondre localement aux consultations,
+ *             "-n NB" pour un déploiement en NB partitions
  */
-int main(void){
+int main(int argc, char *argv[]){
 
     printf("PROJET NSY103 - QUESTION 2.\n");
     printf("Client.\n");
@@ -52,28 +63,86 @@ int main(void){
     pid_t pid = getpid();
     Request msg_req;
     Response msg_resp;
+    bool local_reads = false;
+    int nb_shards = 1;
+    int option;
+
+    while ((option = getopt(argc, argv, "ln:")) != -1) {
+        switch (option) {
+            case 'l':
+                local_reads = true;
+                break;
+            case 'n':
+                nb_shards = atoi(optarg);
+                break;
+            default:
+                fprintf(stderr, "Usage : %s [-l] [-n nb_partitions]\n", argv[0]);
+                exit(EXIT_FAILURE);
+        }
+    }
 
-    initClient();
+    initClient(nb_shards);
+
+    if (local_reads && !initReadCache()) {
+        // le segment sera de nouveau recherché à la prochaine consultation
+        printf("Segment partage indisponible, consultations via le serveur.\n");
+    }
 
     while(1) {
 
         //préparation de le requete en fonction des choix de l'utilisateur
         msg_req.msg_type = getUserRequest(&msg_req.msg);
 
-        //envoi de la requête
-        msg_req.pid = pid; //utilisé pour le type de la réponse
-        if((return_value = msgsnd(msg_queue_id, &msg_req, sizeof(Request) - sizeof(long), 0)) == -1) {
-            perror("Echec msgsnd.\n");
-            exit(EXIT_FAILURE);
+        // consultation en lecture locale, sans passer par le serveur
+        if (local_reads && msg_req.msg_type == REQUEST_CONSULT) {
+            msg_resp.msg = msg_req.msg;
+            msg_resp.status = STATUS_OK;
+            if (readCachedSeats(&msg_resp.msg)) {
+                displayResponse(msg_resp, msg_req);
+                continue;
+            }
         }
 
-        //attente de la réponse
-        if((return_value = msgrcv(msg_queue_id, &msg_resp, sizeof(Response) - sizeof(long), (long) pid, 0)) == -1) {
-            perror("Echec msgrcv.\n");
-            exit(EXIT_FAILURE);
+        //envoi de la requête au serveur propriétaire du spectacle
+        //(file rouverte une fois si elle a été supprimée : bascule sur un secours)
+        msg_req.pid = pid; //utilisé pour le type de la réponse
+        bool answered = false;
+        int nb_busy = 0;
+        for (int attempt = 0; attempt < 2 && !answered; attempt++) {
+            int msg_queue_id = getShardQueueId(msg_req.msg.show_id);
+            if((return_value = msgsnd(msg_queue_id, &msg_req, sizeof(Request) - sizeof(long), 0)) == -1) {
+                if ((errno == EIDRM || errno == EINVAL) && reopenShardQueue(msg_req.msg.show_id)) {
+                    continue;
+                }
+                perror("Echec msgsnd.\n");
+                exit(EXIT_FAILURE);
+            }
+
+            //attente de la réponse
+            if((return_value = msgrcv(msg_queue_id, &msg_resp, sizeof(Response) - sizeof(long), (long) pid, 0)) == -1) {
+                if ((errno == EIDRM || errno == EINVAL) && reopenShardQueue(msg_req.msg.show_id)) {
+                    if (msg_req.msg_type == REQUEST_CONSULT) {
+                        continue; // sans effet sur le serveur : on la renvoie
+                    }
+                    fprintf(stderr, "Serveur interrompu : issue de la reservation inconnue.\n\n");
+                    break;
+                }
+                perror("Echec msgrcv.\n");
+                exit(EXIT_FAILURE);
+            }
+            // serveur saturé : la requête n'a pas été traitée, on la réémet plus tard
+            if (msg_resp.status == STATUS_BUSY && nb_busy < MAX_BUSY_RETRIES) {
+                nb_busy++;
+                usleep(msg_resp.retry_after_ms * 1000);
+                attempt--; // un refus ne compte pas comme une tentative
+                continue;
+            }
+            answered = true;
         }
 
-        displayResponse(msg_resp, msg_req);
+        if (answered) {
+            displayResponse(msg_resp, msg_req);
+        }
     }
 }
 
@@ -89,6 +158,8 @@ void sigint_handler(int sig) {
     printf("\n");
 
     // coté client, on ne ferme pas la messageQueue
+    // mais on détache le segment partagé éventuel
+    closeReadCache();
 
     // On met fin au programme
     printf("Au revoir.\n");
@@ -115,51 +186,32 @@ void setupSignalHandlers() {
 }
 
 
-/**
- * @brief Crée ou récupère une message Queue avec la clé passée en param.
- *
- * @param key La clé IPC utilisée pour identifier la file de messages.
- */
-void setupMsgQueue(key_t key) {
-    // Tente de créer une file de message avec la clef donnée
-    msg_queue_id = msgget(key, 0666 | IPC_CREAT | IPC_EXCL);
-    if (msg_queue_id == -1) {
-        // Si la file de messages existe déjà (errno == EEXIST), tente de l'ouvrir
-        if (errno == EEXIST) {
-            printf("Recuperation de la file de messages.\n");
-            msg_queue_id = msgget(key, 0666);            
-        } else {
-            perror("Creation de la file de messages : Echec.\n");
-            fprintf(stderr, "Erreur %d : %s\n", errno, strerror(errno));
-            exit(EXIT_FAILURE);
-        }
-    } else {
-        printf("Creation de la file de messages : Succes.\n");
-    }
-}
-
-
 /**
  * @brief Initialise le client.
  *
  * Configure les handlers de signaux
- * et initialise la file de messages.
+ * et initialise les files de messages (une par partition).
+ *
+ * @param nb_shards le nb de partitions du déploiement
  */
-void initClient() {
+void initClient(int nb_shards) {
     // Mise en place du handler d'interruption de l'exécution
     setupSignalHandlers();
 
-    // Génération de la clé pour la message queue
-    key_t key = ftok(KEY_FILENAME, KEY_ID);
-
-    // Initialisation de la file de messages avec la clef générée
-    setupMsgQueue(key);
+    // Initialisation des files de messages des partitions
+    if (!initShards(nb_shards)) {
+        exit(EXIT_FAILURE);
+    }
+    if (nb_shards > 1) {
+        printf("Deploiement en %d partitions.\n", nb_shards);
+    }
 }
 
 
 /**
  * @brief Affiche la réponse reçue du serveur en fonction du type de requête.
  *
+ * Si le serveur est resté saturé, la requête est abandonnée.
  * Si l'identifiant du spectacle n'existe pas, un message d'erreur est affiché.
  * Un nombre de places strictement positif indique une réservation acceptée.
  * Si la réservation est refusée, un nombre de places négatif indique le nb de places restantes.
@@ -169,6 +221,11 @@ void initClient() {
  */
 void displayResponse(Response msg_resp, Request msg_req) {
     
+    if (msg_resp.status == STATUS_BUSY) {
+        printf("Serveur surcharge, requete abandonnee : reessayez plus tard.\n\n");
+        return;
+    }
+
     //si la structure est remplie de 0, le server indique que le show n'existe pas
     if (msg_resp.msg.show_id[0] == '\0') {        
         printf("Le serveur indique que le spectacle %s n existe pas.\n\n",
@@ -0,0 +1,268 @@
+/*******************************************************************************
+ * @file client_lib.c
+ * @brief Implémentation de la bibliothèque client de la question 2.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * cf client_lib.h
+ * Routage : une file de messages par partition, ouverte par initShards().
+ *
+ * Lecture locale des places restantes dans le segment partagé (en lecture seule).
+ * Chaque lecture est validée par le compteur de génération du spectacle :
+ * le compteur est relu après la lecture, une valeur impaire ou modifiée
+ * signifie qu'une réservation était en cours et la lecture est recommencée.
+ *
+ * Le client garde aussi, par spectacle, la dernière valeur lue et sa génération :
+ * tant que la génération n'a pas bougé, la valeur en cache est renvoyée telle quelle.
+ *
+ * Un cache de lecture (segment attaché et cache local) est tenu par partition.
+ *
+ * @note si le segment n'existe pas, est fermé par le serveur ou si la lecture
+ * ne se stabilise pas, la consultation repasse par le serveur.
+ ******************************************************************************/
+
+#include "client_lib.h"
+
+#include <sys/shm.h>
+
+#define READ_MAX_RETRIES 64 // nb d'essais de lecture avant de repasser par le serveur
+#define CACHE_INVALID 1 // génération impaire, ne correspond jamais à une entrée stable
+
+// entrée du cache local : dernière valeur lue et génération associée
+typedef struct {
+    Generation generation;
+    signed char nb_seats;
+} CacheEntry;
+
+// cache de lecture d'une partition
+typedef struct {
+    const Message *shows; // tableau des spectacles (lecture seule), NULL si non attaché
+    const Generation *generations; // compteurs de génération du segment
+    CacheEntry *entries; // cache local, une entrée par spectacle
+    int nb_shows;
+} ReadCache;
+
+// variables du module
+static int lib_nb_shards = 1;
+static int shard_queue_ids[MAX_SHARDS]; // file de messages de chaque partition
+static ReadCache read_caches[MAX_SHARDS];
+
+/**
+ * @brief Crée ou récupère la file de messages de chaque partition
+ *
+ * @param nb_shards le nb de partitions du déploiement (1 : serveur unique)
+ * @return true si toutes les files sont disponibles
+ */
+bool initShards(int nb_shards)
+{
+    if (nb_shards < 1 || nb_shards > MAX_SHARDS)
+    {
+        fprintf(stderr, "Nb de partitions non valide : %d (max %d).\n", nb_shards, MAX_SHARDS);
+        return false;
+    }
+    lib_nb_shards = nb_shards;
+    for (int shard = 0; shard < nb_shards; shard++)
+    {
+        key_t key = ftok(KEY_FILENAME, SHARD_KEY_ID(shard));
+        if ((shard_queue_ids[shard] = msgget(key, 0666 | IPC_CREAT)) == -1)
+        {
+            perror("Recuperation de la file de messages : Echec.\n");
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Renvoie la file de messages du serveur propriétaire du spectacle
+ *
+ * @param show_id l'identifiant du spectacle
+ * @return l'identifiant de la file de messages System V
+ */
+int getShardQueueId(const char *show_id)
+{
+    return shard_queue_ids[getShowShard(show_id, lib_nb_shards)];
+}
+
+/**
+ * @brief Rouvre la file de messages du serveur propriétaire du spectacle
+ *
+ * A appeler quand la file a été supprimée (EIDRM / EINVAL) : le serveur
+ * qui reprend la partition (secours après bascule) utilise la même clef.
+ *
+ * @param show_id l'identifiant du spectacle
+ * @return true si la file a été rouverte
+ */
+bool reopenShardQueue(const char *show_id)
+{
+    int shard = getShowShard(show_id, lib_nb_shards);
+    int msg_queue_id = msgget(ftok(KEY_FILENAME, SHARD_KEY_ID(shard)), 0666 | IPC_CREAT);
+
+    if (msg_queue_id == -1)
+    {
+        return false;
+    }
+    shard_queue_ids[shard] = msg_queue_id;
+    return true;
+}
+
+/**
+ * @brief Détache le segment d'une partition et vide son cache local
+ */
+static void closeShardCache(ReadCache *cache)
+{
+    if (cache->shows != NULL)
+    {
+        shmdt(cache->shows);
+        cache->shows = NULL;
+    }
+    free(cache->entries);
+    cache->entries = NULL;
+}
+
+/**
+ * @brief Attache le segment des spectacles d'une partition en lecture seule
+ *
+ * Le nb de spectacles est retrouvé grace à l'entrée de terminaison du tableau,
+ * les compteurs de génération se trouvant juste après.
+ *
+ * @param shard la partition
+ * @return true si le segment est attaché et maintenu par un serveur
+ */
+static bool attachShardCache(int shard)
+{
+    ReadCache *cache = &read_caches[shard];
+    int sharedmem_id;
+    const Message *shows;
+
+    // récupération du segment existant uniquement : c'est le serveur qui le crée
+    if ((sharedmem_id = shmget(ftok(KEY_FILENAME, SHARD_KEY_ID(shard)), 0, 0444)) == -1)
+    {
+        return false;
+    }
+    if ((shows = (const Message *)shmat(sharedmem_id, NULL, SHM_RDONLY)) == (const Message *)-1)
+    {
+        perror("Erreur lors de l attachement a la memoire partagee");
+        return false;
+    }
+
+    // recherche de la terminaison du tableau
+    int i = 0;
+    while (shows[i].show_id[0] != '\0')
+    {
+        i++;
+    }
+    cache->shows = shows;
+    cache->nb_shows = i;
+    cache->generations = (const Generation *)(shows + i + 1);
+
+    if (__atomic_load_n(&cache->generations[i], __ATOMIC_ACQUIRE) == SEGMENT_CLOSED)
+    {
+        // segment orphelin, le serveur est en cours d'arrêt
+        closeShardCache(cache);
+        return false;
+    }
+
+    // cache local vide : aucune génération ne correspond
+    cache->entries = (CacheEntry *)malloc(i * sizeof(CacheEntry));
+    for (int j = 0; j < i; j++)
+    {
+        cache->entries[j].generation = CACHE_INVALID;
+    }
+    return true;
+}
+
+/**
+ * @brief Attache les segments des spectacles de toutes les partitions
+ *
+ * @return true si tous les segments sont attachés et maintenus par un serveur
+ * (les segments manquants seront de nouveau recherchés à la consultation)
+ */
+bool initReadCache()
+{
+    bool all_attached = true;
+
+    for (int shard = 0; shard < lib_nb_shards; shard++)
+    {
+        all_attached = attachShardCache(shard) && all_attached;
+    }
+    return all_attached;
+}
+
+/**
+ * @brief Détache les segments des spectacles et vide les caches locaux
+ */
+void closeReadCache()
+{
+    for (int shard = 0; shard < lib_nb_shards; shard++)
+    {
+        closeShardCache(&read_caches[shard]);
+    }
+}
+
+/**
+ * @brief Répond localement à une consultation
+ *
+ * Même convention que le serveur : un spectacle inconnu est signifié
+ * par tous les bits du message à 0.
+ *
+ * @param Message* le message de consultation, qui va recevoir le nb de places
+ * @return true si la réponse est locale, false s'il faut passer par le serveur
+ */
+bool readCachedSeats(Message *msg)
+{
+    int shard = getShowShard(msg->show_id, lib_nb_shards);
+    ReadCache *cache = &read_caches[shard];
+
+    if (cache->shows == NULL && !attachShardCache(shard))
+    {
+        return false;
+    }
+    if (__atomic_load_n(&cache->generations[cache->nb_shows], __ATOMIC_ACQUIRE) == SEGMENT_CLOSED)
+    {
+        // le serveur a supprimé le segment : on le relâchera pour le suivant
+        closeShardCache(cache);
+        return false;
+    }
+
+    // recherche de l'index du spectacle
+    bool found = false;
+    int i = -1;
+    while (!found && (++i < cache->nb_shows))
+    {
+        found = strcmp(msg->show_id, cache->shows[i].show_id) == 0;
+    }
+    if (!found)
+    {
+        memset(msg, 0, sizeof(Message));
+        return true;
+    }
+
+    for (int tries = 0; tries < READ_MAX_RETRIES; tries++)
+    {
+        Generation before = __atomic_load_n(&cache->generations[i], __ATOMIC_ACQUIRE);
+        if (before & 1)
+        {
+            // réservation en cours d'écriture
+            continue;
+        }
+        if (before == cache->entries[i].generation)
+        {
+            // rien n'a changé depuis la dernière lecture
+            msg->nb_seats = cache->entries[i].nb_seats;
+            return true;
+        }
+        signed char nb_seats = __atomic_load_n(&cache->shows[i].nb_seats, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&cache->generations[i], __ATOMIC_RELAXED) == before)
+        {
+            // lecture cohérente, on la garde en cache
+            cache->entries[i].generation = before;
+            cache->entries[i].nb_seats = nb_seats;
+            msg->nb_seats = nb_seats;
+            return true;
+        }
+    }
+    return false;
+}
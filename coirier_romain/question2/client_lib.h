@@ -0,0 +1,35 @@
+/*******************************************************************************
+ * @file client_lib.h
+ * @brief Fonctions de la bibliothèque client de la question 2.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * Routage : en déploiement partitionné (cf common.h), chaque requête est envoyée
+ * sur la file de messages du serveur propriétaire du spectacle
+ * (getShardQueueId()), la réponse revenant sur cette même file.
+ * Une file supprimée (arrêt ou bascule du serveur) est rouverte par reopenShardQueue().
+ *
+ * Mode lecture locale : le client attache les segments partagés des spectacles
+ * en lecture seule et répond lui-même aux consultations,
+ * sans aller-retour par la file de messages.
+ * Les réservations passent toujours par le serveur.
+ *
+ * @note la cohérence des lectures est assurée par les compteurs de génération
+ * de chaque spectacle (cf common.h), sans prendre le sémaphore du serveur.
+ ******************************************************************************/
+
+#ifndef CLIENT_LIB_H
+#define CLIENT_LIB_H
+
+#include "common.h"
+
+//prototypes de fonctions
+bool initShards(int nb_shards);
+int getShardQueueId(const char *show_id);
+bool reopenShardQueue(const char *show_id);
+bool initReadCache();
+bool readCachedSeats(Message *msg);
+void closeReadCache();
+
+#endif
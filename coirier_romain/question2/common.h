@@ -16,6 +16,14 @@
  *     > 0 en consultation : réponse ; en réservation : demande / accusé
  *     < 0 en réservation refus avec indication des places restantes
  * 
+ * Déploiement partitionné : NB serveurs indépendants (option -n NB, numéro -s N)
+ * se partagent le catalogue, chaque spectacle appartenant au serveur
+ * getShowShard(show_id, NB). Chaque serveur a ses propres file de messages,
+ * sémaphore et segment partagé, de clef ftok(KEY_FILENAME, SHARD_KEY_ID(N)) :
+ * aucun verrou n'est commun à deux partitions. Le client route chaque requête
+ * vers la file du serveur propriétaire (cf client_lib.h).
+ * Sans option, un serveur unique (partition 0 sur 1) possède tout le catalogue.
+ * 
  * @bug ?.
  ******************************************************************************/
 
@@ -43,8 +51,13 @@
 // CONSTANTES
 #define KEY_FILENAME "NSY"
 #define KEY_ID 103
+#define MAX_SHARDS 16 // nb max de serveurs en déploiement partitionné
+#define MAX_CATALOG_SIZE 16000000 // nb max de spectacles générés (option -c du serveur)
+#define SHARD_KEY_ID(shard) (KEY_ID + (shard)) // identifiant ftok de la partition
 
-#define RESOURCE_SEM 0 // indexes du semaphore dans la table
+#define RESOURCE_SEM 0 // indexes des semaphores dans la table
+#define HEAP_SEM 1 // tas partagé (cf shm_heap.h)
+#define NB_SEMS 2
 
 // Tableau des noms de spectacles (6 caractères exactement)
 static const char *const SHOW_IDS[] = {
@@ -54,6 +67,26 @@ static const char *const SHOW_IDS[] = {
     NULL // terminaison du tableau
 };
 
+/**
+ * @brief Renvoie la partition (serveur) propriétaire d'un spectacle
+ *
+ * Hachage FNV-1a de l'identifiant du spectacle, modulo le nb de partitions.
+ *
+ * @param show_id l'identifiant du spectacle
+ * @param nb_shards le nb de partitions du déploiement
+ * @return le numéro de la partition, entre 0 et nb_shards - 1
+ */
+static inline int getShowShard(const char *show_id, int nb_shards)
+{
+    unsigned int hash = 2166136261U;
+    while (*show_id != '\0')
+    {
+        hash ^= (unsigned char)*show_id++;
+        hash *= 16777619U;
+    }
+    return hash % nb_shards;
+}
+
 // Types de requête
 typedef enum {
     REQUEST_CONSULT = 1, // requête en consultation
@@ -74,9 +107,22 @@ typedef struct {
     pid_t pid;
 } Request;
 
+#define STATUS_OK 0 // requête traitée
+#define STATUS_BUSY 1 // serveur saturé, requête non traitée : réémettre après retry_after_ms
+
 typedef struct {
     long msg_type;
     Message msg;
+    int status; // STATUS_OK, STATUS_BUSY
+    int retry_after_ms; // délai de réémission conseillé (STATUS_BUSY)
 } Response;
 
+// Compteurs de génération (un par spectacle)
+// placés dans le segment partagé juste après le tableau des spectacles (terminaison comprise) :
+// -> pair : entrée stable ; impair : écriture en cours par le serveur
+// Le compteur de l'entrée de terminaison sert d'indicateur de fermeture du segment.
+typedef unsigned int Generation;
+#define SEGMENT_OPEN 0
+#define SEGMENT_CLOSED 1
+
 #endif
\ No newline at end of file
@@ -1,13 +1,16 @@
 #!/bin/bash
 
 # Sources
-CLIENT_SRC="client.c" 
-SERVER_SRC="server.c"
+CLIENT_SRC="client.c client_lib.c"
+SERVER_SRC="server.c numa_placement.c replication.c admission.c shm_slab.c shm_heap.c show_index.c show_lookup.c huge_pages.c lock_profile.c handover.c pending_replies.c"
 
 # Executables
 CLIENT_OUT="client"
 SERVER_OUT="server"
 
+# Nb de serveurs (déploiement partitionné par spectacle si > 1)
+NB_SHARDS=${NB_SHARDS:-1}
+
 # Compilation
 GCC_FLAGS= "" #"-Wall -Werror"
 echo "Compilation du client..."
@@ -26,10 +29,12 @@ fi
 
 echo "Succes de la compilation."
 
-# Lancement du server
+# Lancement du server (un par partition)
 echo "Lancement du serveur..."
-./$SERVER_OUT &
+for ((SHARD = 0; SHARD < NB_SHARDS; SHARD++)); do
+    ./$SERVER_OUT -n $NB_SHARDS -s $SHARD &
+done
 sleep 1 # Delai pour l'init des serveurs
 
 echo "Lancement du client..."
-gnome-terminal -- ./$CLIENT_OUT
+gnome-terminal -- ./$CLIENT_OUT -n $NB_SHARDS
@@ -0,0 +1,153 @@
+/*******************************************************************************
+ * @file handover.c
+ * @brief Implémentation de la passation des outils IPC de la question 2.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * cf handover.h
+ * SIGUSR2 n'interrompt msgrcv que s'il arrive pendant l'attente : il est donc
+ * relancé jusqu'à ce que le destinataire l'ait pris en compte (ou soit terminé).
+ ******************************************************************************/
+
+#include "handover.h"
+#include "server.h"
+#include "admission.h"
+#include "pending_replies.h"
+
+#include <sys/shm.h>
+#include <sys/wait.h>
+#include <signal.h>
+#include <time.h>
+
+// variables du module
+static pid_t server_pid; // père de ce serveur (hérité par les fils)
+static bool handover_mode; // option -U
+
+/**
+ * @brief Retient le père du serveur, avant le fork du serveur de consultation
+ *
+ * @param handover true : reprise des outils IPC d'un serveur en service (option -U)
+ */
+void initHandOver(bool handover)
+{
+    server_pid = getpid();
+    handover_mode = handover;
+}
+
+/**
+ * @brief Indique si un process existe encore
+ *
+ * Un process terminé mais pas encore attendu par son père (zombi) compte
+ * comme disparu : c'est le cas du père d'un serveur tué (kill -9).
+ */
+bool isProcessAlive(pid_t pid)
+{
+    char path[32];
+    char state = 0;
+    FILE *stat_file;
+
+    if (pid <= 0 || (kill(pid, 0) == -1 && errno != EPERM))
+    {
+        return false;
+    }
+    // état du process : "pid (nom) état ...", le nom peut contenir des espaces
+    snprintf(path, sizeof(path), "/proc/%d/stat", pid);
+    if ((stat_file = fopen(path, "r")) != NULL)
+    {
+        char line[256];
+        if (fgets(line, sizeof(line), stat_file) != NULL && strrchr(line, ')') != NULL)
+        {
+            sscanf(strrchr(line, ')') + 1, " %c", &state);
+        }
+        fclose(stat_file);
+    }
+    return state != 'Z' && state != 'X';
+}
+
+/**
+ * @brief Attente entre deux relances du signal de passation
+ */
+static void waitRetry()
+{
+    struct timespec retry_delay = {0, HANDOVER_RETRY_MS * 1000000L};
+    nanosleep(&retry_delay, NULL);
+}
+
+/**
+ * @brief Inscrit ce serveur comme serveur en service (père, après initServer())
+ *
+ * En mode passation, demande à l'ancien serveur de s'arrêter et attend qu'il
+ * ait cessé de retirer des requêtes de la file.
+ */
+void takeOverServer()
+{
+    pid_t previous_pid = __atomic_exchange_n(&server_stats->server_pid, server_pid, __ATOMIC_ACQ_REL);
+
+    if (!handover_mode)
+    {
+        return;
+    }
+    if (previous_pid == server_pid || !isProcessAlive(previous_pid))
+    {
+        printf("%s : Passation : aucun serveur en service.\n", process_name);
+        return;
+    }
+    printf("%s : Passation : arret du serveur %d...\n", process_name, previous_pid);
+    while (__atomic_load_n(&server_stats->draining_pid, __ATOMIC_ACQUIRE) != previous_pid
+        && kill(previous_pid, SIGUSR2) == 0)
+    {
+        waitRetry();
+    }
+    printf("%s : Passation : le serveur %d termine ses requetes en cours.\n", process_name, previous_pid);
+}
+
+/**
+ * @brief Indique si un autre serveur a repris les outils IPC de celui-ci
+ */
+bool isHandedOver()
+{
+    return server_stats != NULL
+        && __atomic_load_n(&server_stats->server_pid, __ATOMIC_ACQUIRE) != server_pid;
+}
+
+/**
+ * @brief Arrêt de l'ancien serveur après passation (père) : fin des requêtes en cours
+ *
+ * Arrête le serveur de consultation, attend les fils de réservation
+ * (zombis non conservés : wait() rend la main quand il n'en reste plus)
+ * puis quitte sans supprimer les outils IPC.
+ *
+ * @param consult_pid le serveur de consultation
+ */
+void drainServer(pid_t consult_pid)
+{
+    __atomic_store_n(&server_stats->draining_pid, server_pid, __ATOMIC_RELEASE);
+    printf("%s : Passation : plus de nouvelles requetes.\n", process_name);
+    // fiches de réservation gardées par le père : rendues aux autres serveurs
+    releaseRecordCache();
+    // refus en attente de place dans la file : remis avant l'arrêt
+    sendPendingReplies();
+
+    while (kill(consult_pid, SIGUSR2) == 0)
+    {
+        waitRetry();
+    }
+    printf("%s : Passation : attente des reservations en cours...\n", process_name);
+    while (wait(NULL) != -1 || errno == EINTR);
+    leaveServer();
+}
+
+/**
+ * @brief Quitte sans supprimer les outils IPC, repris par un autre serveur
+ */
+void leaveServer()
+{
+    printf("\n");
+    printf("%s : Outils IPC conserves pour le serveur %d.\n", process_name,
+        __atomic_load_n(&server_stats->server_pid, __ATOMIC_ACQUIRE));
+    printf("%s : Détachement du segment de mémoire partagé.\n", process_name);
+    shmdt(shows);
+    printf("%s : Au revoir.\n", process_name);
+    exit(EXIT_SUCCESS);
+}
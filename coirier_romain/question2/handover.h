@@ -0,0 +1,38 @@
+/*******************************************************************************
+ * @file handover.h
+ * @brief Passation des outils IPC entre deux serveurs de la question 2 (option -U).
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * Mise à jour sans interruption : le nouveau serveur, lancé avec -U et les mêmes
+ * options de partition et de catalogue, reprend la file de messages, les sémaphores
+ * (sans les réinitialiser) et le segment (tableau, index, journal, compteurs)
+ * de l'ancien, puis lui envoie SIGUSR2. L'ancien serveur :
+ * -> cesse de retirer des requêtes de la file (les suivantes y attendent le nouveau)
+ * -> termine le lot de consultations en cours et attend ses fils de réservation
+ * -> se détache du segment et s'arrête sans rien supprimer (pas d'IPC_RMID)
+ * Aucune requête n'est perdue et le tableau n'est pas recréé.
+ *
+ * Le père du serveur en service est inscrit dans le segment (ServerStats) :
+ * l'ancien serveur, interrompu ensuite par Ctrl + c, ne supprime plus
+ * les outils IPC du nouveau. L'émetteur de réplication (option -R), qui ne lit
+ * que le journal du segment, survit à la passation : le secours reste connecté.
+ ******************************************************************************/
+
+#ifndef HANDOVER_H
+#define HANDOVER_H
+
+#include "common.h"
+
+#define HANDOVER_RETRY_MS 20 // relance du signal de passation (signal reçu hors de msgrcv)
+
+//prototypes de fonctions
+void initHandOver(bool handover);
+void takeOverServer();
+bool isProcessAlive(pid_t pid);
+bool isHandedOver();
+void drainServer(pid_t consult_pid);
+void leaveServer();
+
+#endif
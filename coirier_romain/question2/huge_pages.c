@@ -0,0 +1,55 @@
+/*******************************************************************************
+ * @file huge_pages.c
+ * @brief Implémentation des segments en grandes pages de la question 2.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * cf huge_pages.h
+ ******************************************************************************/
+
+#include "huge_pages.h"
+
+#include <sys/shm.h>
+#include <sys/mman.h>
+
+/**
+ * @brief Crée un segment partagé, en grandes pages si demandé et possible
+ *
+ * @param key la clef du segment (IPC_PRIVATE pour une extension du tas)
+ * @param size la taille minimale du segment
+ * @param huge_pages true : essai en grandes pages (taille arrondie à HUGE_PAGE_SIZE)
+ * @return int : l'identifiant du segment, -1 en cas d'échec
+ */
+int createHugeSegment(key_t key, size_t size, bool huge_pages)
+{
+    int id;
+
+    if (huge_pages)
+    {
+        size_t huge_size = (size + HUGE_PAGE_SIZE - 1) & ~((size_t)HUGE_PAGE_SIZE - 1);
+        if ((id = shmget(key, huge_size, 0666 | IPC_CREAT | SHM_HUGETLB)) != -1)
+        {
+            return id;
+        }
+        // pas de grandes pages réservées : repli en pages normales
+        fprintf(stderr, "Segment de %zu Ko en grandes pages impossible (%s), repli en pages normales.\n",
+            huge_size / 1024, strerror(errno));
+    }
+    return shmget(key, size, 0666 | IPC_CREAT);
+}
+
+/**
+ * @brief Demande les grandes pages transparentes pour un segment attaché
+ *
+ * Sans effet sur un segment SHM_HUGETLB, ou si le noyau ne le permet pas.
+ *
+ * @param address l'adresse d'attachement
+ * @param size la taille du segment
+ */
+void adviseHugePages(void *address, size_t size)
+{
+#ifdef MADV_HUGEPAGE
+    madvise(address, size, MADV_HUGEPAGE);
+#endif
+}
@@ -0,0 +1,32 @@
+/*******************************************************************************
+ * @file huge_pages.h
+ * @brief Segments partagés en grandes pages du serveur de la question 2.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * Avec un grand catalogue (option -c du serveur), les recherches au hasard
+ * dans le tableau des spectacles et dans son index (cf show_index.h) touchent
+ * chacune une page différente : avec des pages de 4 Ko, presque chaque accès
+ * manque dans le TLB. Avec l'option -H, le segment principal et les extensions
+ * du tas partagé sont créés en grandes pages (SHM_HUGETLB, HUGE_PAGE_SIZE) :
+ * un TLB de quelques centaines d'entrées couvre alors des centaines de Mo.
+ *
+ * Repli transparent : sans grandes pages réservées (vm.nr_hugepages),
+ * le segment est créé en pages normales et marqué MADV_HUGEPAGE pour les
+ * grandes pages transparentes (si /sys/kernel/mm/transparent_hugepage/shmem_enabled
+ * le permet). bench_hugepages.c mesure le gain.
+ ******************************************************************************/
+
+#ifndef HUGE_PAGES_H
+#define HUGE_PAGES_H
+
+#include "common.h"
+
+#define HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+//prototypes de fonctions
+int createHugeSegment(key_t key, size_t size, bool huge_pages);
+void adviseHugePages(void *address, size_t size);
+
+#endif
@@ -0,0 +1,148 @@
+/*******************************************************************************
+ * @file lock_profile.c
+ * @brief Implémentation du profil d'attente des sémaphores de la question 2.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * cf lock_profile.h
+ * Les compteurs, communs à tous les process du serveur, sont modifiés par des
+ * opérations atomiques ; l'attente max et son spectacle ne sont pas mis à jour
+ * ensemble (le spectacle affiché peut être celui d'une attente voisine).
+ ******************************************************************************/
+
+#include "lock_profile.h"
+#include "server.h"
+#include "admission.h"
+
+#include <time.h>
+
+static const char *const SITE_NAMES[LOCK_NB_SITES] = {
+    "consultation", "reservation", "tas partage"
+};
+
+/**
+ * @brief Instant courant en ns
+ */
+static long nowNs()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000000000L + now.tv_nsec;
+}
+
+/**
+ * @brief semop() précédé d'un essai sans attente
+ *
+ * Une attente interrompue par un signal (SIGUSR1) reprend.
+ *
+ * @return bool : true si les opérations ont dû attendre un autre process
+ */
+bool semopContended(struct sembuf *operations, int nb_operations)
+{
+    int return_value;
+
+    for (int i = 0; i < nb_operations; i++)
+    {
+        operations[i].sem_flg |= IPC_NOWAIT;
+    }
+    return_value = semop(semset_id, operations, nb_operations);
+    for (int i = 0; i < nb_operations; i++)
+    {
+        operations[i].sem_flg &= ~IPC_NOWAIT;
+    }
+    if (return_value == 0 || errno != EAGAIN)
+    {
+        return false;
+    }
+    while (semop(semset_id, operations, nb_operations) == -1)
+    {
+        if (errno != EINTR)
+        {
+            perror("Echec semop.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Demande du sémaphore (avant le P())
+ */
+void beginLockWait(LockTiming *timing)
+{
+    timing->request_ns = nowNs();
+}
+
+/**
+ * @brief Obtention du sémaphore (après le P())
+ *
+ * @param contended true si le P() a dû attendre
+ */
+void lockAcquired(LockTiming *timing, bool contended)
+{
+    timing->acquired_ns = nowNs();
+    timing->contended = contended;
+}
+
+/**
+ * @brief Fin de la section critique (avant le V()) : cumul de la mesure
+ *
+ * @param site l'opération en section critique
+ * @param show_index le spectacle concerné (LOCK_BATCH_SHOW : lot)
+ */
+void lockReleased(const LockTiming *timing, LockSite site, int show_index)
+{
+    LockCounters *counters = &server_stats->locks[site];
+    unsigned long long wait_ns = timing->acquired_ns - timing->request_ns;
+
+    __atomic_add_fetch(&counters->nb_acquisitions, 1, __ATOMIC_RELAXED);
+    if (timing->contended)
+    {
+        __atomic_add_fetch(&counters->nb_contended, 1, __ATOMIC_RELAXED);
+    }
+    __atomic_add_fetch(&counters->wait_ns, wait_ns, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&counters->hold_ns, nowNs() - timing->acquired_ns, __ATOMIC_RELAXED);
+    unsigned long long max_wait_ns = __atomic_load_n(&counters->max_wait_ns, __ATOMIC_RELAXED);
+    while (wait_ns > max_wait_ns)
+    {
+        if (__atomic_compare_exchange_n(&counters->max_wait_ns, &max_wait_ns, wait_ns,
+            true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        {
+            __atomic_store_n(&counters->max_wait_show, show_index, __ATOMIC_RELAXED);
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Affiche le profil par opération
+ */
+void printLockProfile()
+{
+    printf("Semaphores (attente / tenue en us) :\n");
+    printf("  %-12s %10s %10s %10s %10s %10s %9s  %s\n", "operation", "acquis.", "contendues",
+        "attente", "att. max", "tenue", "att/tenue", "spectacle de l'att. max");
+    for (int site = 0; site < LOCK_NB_SITES; site++)
+    {
+        LockCounters counters;
+        counters.nb_acquisitions = __atomic_load_n(&server_stats->locks[site].nb_acquisitions, __ATOMIC_RELAXED);
+        counters.nb_contended = __atomic_load_n(&server_stats->locks[site].nb_contended, __ATOMIC_RELAXED);
+        counters.wait_ns = __atomic_load_n(&server_stats->locks[site].wait_ns, __ATOMIC_RELAXED);
+        counters.hold_ns = __atomic_load_n(&server_stats->locks[site].hold_ns, __ATOMIC_RELAXED);
+        counters.max_wait_ns = __atomic_load_n(&server_stats->locks[site].max_wait_ns, __ATOMIC_RELAXED);
+        counters.max_wait_show = __atomic_load_n(&server_stats->locks[site].max_wait_show, __ATOMIC_RELAXED);
+        if (counters.nb_acquisitions == 0)
+        {
+            continue;
+        }
+
+        double nb = (double)counters.nb_acquisitions;
+        printf("  %-12s %10lu %9.1f%% %10.2f %10.2f %10.2f %9.2f  %s\n", SITE_NAMES[site],
+            counters.nb_acquisitions, 100.0 * counters.nb_contended / nb,
+            counters.wait_ns / nb / 1e3, counters.max_wait_ns / 1e3, counters.hold_ns / nb / 1e3,
+            counters.hold_ns > 0 ? (double)counters.wait_ns / counters.hold_ns : 0.0,
+            (counters.max_wait_show >= 0 && counters.max_wait_show < getNbShows())
+                ? shows[counters.max_wait_show].show_id : "-");
+    }
+}
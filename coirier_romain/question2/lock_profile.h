@@ -0,0 +1,60 @@
+/*******************************************************************************
+ * @file lock_profile.h
+ * @brief Profil d'attente des sémaphores de la question 2.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * Chaque section critique sur un sémaphore du serveur est mesurée :
+ * -> beginLockWait() avant le P(), fait par semopContended() qui indique
+ *    s'il a fallu attendre un autre process
+ * -> lockAcquired() après le P()
+ * -> lockReleased() juste avant le V()
+ * Attente, tenue, attente max (avec le spectacle concerné) et nb d'acquisitions
+ * contendues sont cumulés par opération dans les compteurs du serveur
+ * (segment partagé, cf admission.h) : les fils de réservation, le serveur de
+ * consultation et le père y contribuent. Affichage sur SIGUSR1.
+ ******************************************************************************/
+
+#ifndef LOCK_PROFILE_H
+#define LOCK_PROFILE_H
+
+#include "common.h"
+
+#include <sys/sem.h>
+
+#define LOCK_BATCH_SHOW -1 // section portant sur un lot de spectacles (consultations)
+
+// Opérations en section critique
+typedef enum {
+    LOCK_CONSULT, // RESOURCE_SEM : lot de consultations (getNbSeats())
+    LOCK_BOOK, // RESOURCE_SEM : réservation (bookSeats())
+    LOCK_HEAP, // HEAP_SEM : allocation dans le tas partagé
+    LOCK_NB_SITES
+} LockSite;
+
+// Compteurs d'une opération (dans le segment partagé)
+typedef struct {
+    unsigned long nb_acquisitions;
+    unsigned long nb_contended; // acquisitions ayant dû attendre
+    unsigned long long wait_ns;
+    unsigned long long hold_ns;
+    unsigned long long max_wait_ns;
+    int max_wait_show; // spectacle de l'attente max (LOCK_BATCH_SHOW : lot)
+} LockCounters;
+
+// Mesure d'une section critique
+typedef struct {
+    long request_ns; // demande du sémaphore
+    long acquired_ns; // obtention
+    bool contended; // P() bloqué
+} LockTiming;
+
+//prototypes de fonctions
+bool semopContended(struct sembuf *operations, int nb_operations);
+void beginLockWait(LockTiming *timing);
+void lockAcquired(LockTiming *timing, bool contended);
+void lockReleased(const LockTiming *timing, LockSite site, int show_index);
+void printLockProfile();
+
+#endif
@@ -0,0 +1,114 @@
+/*******************************************************************************
+ * @file numa_placement.c
+ * @brief Implémentation du placement NUMA de la question 2.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * cf numa_placement.h
+ * La topologie est lue dans /sys/devices/system/node et la politique mémoire
+ * posée par l'appel système mbind, sans dépendre de libnuma.
+ ******************************************************************************/
+
+#define _GNU_SOURCE // sched_setaffinity()
+
+#include "numa_placement.h"
+
+#include <sched.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+
+#define NODE_PATH "/sys/devices/system/node/node%d"
+#define NODE_CPULIST_PATH NODE_PATH "/cpulist"
+#define MAX_NUMA_NODES 64
+
+/**
+ * @brief Renvoie le nb de noeuds NUMA de la machine (au moins 1)
+ */
+int getNbNumaNodes()
+{
+    char path[64];
+    int nb_nodes = 0;
+
+    // les noeuds sont numérotés de façon contiguë
+    do
+    {
+        snprintf(path, sizeof(path), NODE_PATH, nb_nodes);
+    } while (access(path, F_OK) == 0 && ++nb_nodes < MAX_NUMA_NODES);
+
+    return (nb_nodes == 0) ? 1 : nb_nodes;
+}
+
+/**
+ * @brief Epingle le process (et ses futurs fils) sur les CPU d'un noeud NUMA
+ *
+ * La liste des CPU du noeud est de la forme "0-3,8-11".
+ *
+ * @param node le noeud
+ * @return true si l'affinité a été posée
+ */
+bool pinToNumaNode(int node)
+{
+    char path[64];
+    FILE *cpulist;
+    cpu_set_t cpus;
+    int first, last;
+
+    snprintf(path, sizeof(path), NODE_CPULIST_PATH, node);
+    if ((cpulist = fopen(path, "r")) == NULL)
+    {
+        return false;
+    }
+    CPU_ZERO(&cpus);
+    while (fscanf(cpulist, "%d", &first) == 1)
+    {
+        last = first;
+        int separator = fgetc(cpulist);
+        if (separator == '-')
+        {
+            if (fscanf(cpulist, "%d", &last) != 1)
+            {
+                break;
+            }
+            separator = fgetc(cpulist);
+        }
+        for (int cpu = first; cpu <= last && cpu < CPU_SETSIZE; cpu++)
+        {
+            CPU_SET(cpu, &cpus);
+        }
+        if (separator != ',')
+        {
+            break;
+        }
+    }
+    fclose(cpulist);
+
+    if (CPU_COUNT(&cpus) == 0 || sched_setaffinity(0, sizeof(cpus), &cpus) == -1)
+    {
+        perror("Erreur sched_setaffinity.\n");
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Alloue une zone mémoire (non encore accédée) sur un noeud NUMA
+ *
+ * Les pages déjà présentes sont migrées (MPOL_MF_MOVE).
+ *
+ * @param addr le début de la zone, aligné sur une page (ex : segment attaché)
+ * @param length la taille de la zone
+ * @param node le noeud
+ * @return true si la politique mémoire a été posée
+ */
+bool bindToNumaNode(void *addr, size_t length, int node)
+{
+    unsigned long nodemask = 1UL << node;
+
+    if (syscall(SYS_mbind, addr, length, MPOL_BIND, &nodemask, MAX_NUMA_NODES + 1, MPOL_MF_MOVE) == -1)
+    {
+        perror("Erreur mbind.\n");
+        return false;
+    }
+    return true;
+}
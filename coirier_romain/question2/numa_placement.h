@@ -0,0 +1,28 @@
+/*******************************************************************************
+ * @file numa_placement.h
+ * @brief Placement NUMA des serveurs partitionnés de la question 2.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * En déploiement partitionné (cf common.h), la partition N est placée sur le
+ * noeud NUMA N % nb de noeuds : les process du serveur sont épinglés sur les CPU
+ * du noeud et le segment des spectacles y est alloué (mbind avant le premier accès).
+ * Chaque requête étant routée vers le serveur propriétaire du spectacle,
+ * elle est traitée sur le noeud qui porte ses données.
+ *
+ * @note sans noeud NUMA exposé par le noyau (/sys/devices/system/node),
+ * la machine est considérée comme un noeud unique.
+ ******************************************************************************/
+
+#ifndef NUMA_PLACEMENT_H
+#define NUMA_PLACEMENT_H
+
+#include "common.h"
+
+//prototypes de fonctions
+int getNbNumaNodes();
+bool pinToNumaNode(int node);
+bool bindToNumaNode(void *addr, size_t length, int node);
+
+#endif
@@ -0,0 +1,167 @@
+/*******************************************************************************
+ * @file pending_replies.c
+ * @brief Implémentation des réponses différées de la question 2.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * cf pending_replies.h
+ ******************************************************************************/
+
+#include "pending_replies.h"
+#include "server.h"
+
+#include <time.h>
+
+// Réponse en attente de place dans la file
+typedef struct PendingReply {
+    Response msg_resp;
+    struct PendingReply *next;
+} PendingReply;
+
+// variables du module
+static PendingReply *first_reply = NULL; // la plus ancienne, réémise en premier
+static PendingReply *last_reply = NULL;
+static unsigned long nb_pending = 0;
+
+/**
+ * @brief Dépose une réponse dans la file sans attendre
+ *
+ * @return bool : false si la file est pleine
+ */
+static bool trySend(const Response *msg_resp)
+{
+    if (msgsnd(msg_queue_id, msg_resp, sizeof(Response) - sizeof(long), IPC_NOWAIT) == -1)
+    {
+        if (errno != EAGAIN)
+        {
+            perror("Echec msgsnd.\n");
+            exit(EXIT_FAILURE);
+        }
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Envoie une réponse sans attendre, différée si la file est pleine
+ *
+ * Les réponses déjà différées passent avant (ordre d'arrivée conservé).
+ *
+ * @param msg_resp la réponse (type : pid du client)
+ */
+void sendReplyNoWait(const Response *msg_resp)
+{
+    PendingReply *reply;
+
+    if (first_reply == NULL && trySend(msg_resp))
+    {
+        return;
+    }
+    if ((reply = (PendingReply *)malloc(sizeof(PendingReply))) == NULL)
+    {
+        perror("Echec malloc.\n");
+        exit(EXIT_FAILURE);
+    }
+    reply->msg_resp = *msg_resp;
+    reply->next = NULL;
+    if (last_reply == NULL)
+    {
+        first_reply = reply;
+    }
+    else
+    {
+        last_reply->next = reply;
+    }
+    last_reply = reply;
+    if (++nb_pending % 1024 == 1)
+    {
+        printf("%s : File pleine : %lu reponses differees.\n", process_name, nb_pending);
+    }
+}
+
+/**
+ * @brief Réémet les réponses différées, tant que la file a de la place
+ */
+void flushPendingReplies()
+{
+    while (first_reply != NULL && trySend(&first_reply->msg_resp))
+    {
+        PendingReply *sent = first_reply;
+        first_reply = sent->next;
+        if (first_reply == NULL)
+        {
+            last_reply = NULL;
+        }
+        free(sent);
+        nb_pending--;
+    }
+}
+
+/**
+ * @brief Envoie toutes les réponses différées, en attendant la place nécessaire
+ *
+ * Pour un père qui ne retire plus de requêtes (passation, cf handover.h) :
+ * la file est vidée par le nouveau serveur.
+ */
+void sendPendingReplies()
+{
+    while (first_reply != NULL)
+    {
+        PendingReply *sent = first_reply;
+        if (msgsnd(msg_queue_id, &sent->msg_resp, sizeof(Response) - sizeof(long), 0) == -1)
+        {
+            if (errno != EINTR)
+            {
+                perror("Echec msgsnd.\n");
+                exit(EXIT_FAILURE);
+            }
+            continue;
+        }
+        first_reply = sent->next;
+        free(sent);
+        nb_pending--;
+    }
+    last_reply = NULL;
+}
+
+/**
+ * @brief Indique s'il reste des réponses différées
+ */
+bool hasPendingReplies()
+{
+    return first_reply != NULL;
+}
+
+/**
+ * @brief Reçoit une requête, sans bloquer tant que des réponses sont différées
+ *
+ * Réémet les réponses différées entre deux essais de réception.
+ *
+ * @param msg_req reçoit la requête
+ * @param request_type le type de message attendu
+ * @return int : la taille du message reçu, -1 sur erreur de msgrcv ou signal (errno EINTR)
+ */
+int receiveAndFlush(Request *msg_req, long request_type)
+{
+    struct timespec retry_delay = {0, PENDING_RETRY_US * 1000L};
+    int return_value;
+
+    while (1)
+    {
+        flushPendingReplies();
+        if (!hasPendingReplies())
+        {
+            return msgrcv(msg_queue_id, msg_req, sizeof(Request) - sizeof(long), request_type, 0);
+        }
+        return_value = msgrcv(msg_queue_id, msg_req, sizeof(Request) - sizeof(long), request_type, IPC_NOWAIT);
+        if (return_value != -1 || errno != ENOMSG)
+        {
+            return return_value;
+        }
+        if (nanosleep(&retry_delay, NULL) == -1)
+        {
+            return -1; // interrompu par un signal (statistiques, passation)
+        }
+    }
+}
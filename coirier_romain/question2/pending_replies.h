@@ -0,0 +1,37 @@
+/*******************************************************************************
+ * @file pending_replies.h
+ * @brief Réponses différées du serveur de réservation de la question 2.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * Le père est le seul à retirer les réservations de la file, le serveur de
+ * consultation les consultations : aucun ne doit attendre de la place pour y
+ * déposer une réponse (refus STATUS_BUSY du père, cf admission.h ; réponses
+ * aux consultations).
+ * sendReplyNoWait() envoie sans attente ; si la file est pleine, la réponse
+ * est mise de côté (dans l'ordre d'arrivée) au lieu d'être perdue, puis réémise
+ * par flushPendingReplies() avant chaque réception. Tant qu'il reste des
+ * réponses différées, la réception ne bloque pas (receiveAndFlush()) :
+ * chaque requête retirée libère de la place dans la file.
+ * Le client, qui attend sa réponse par un msgrcv bloquant, la reçoit donc toujours.
+ *
+ * Liste chaînée allouée à la demande, propre à chacun des 2 process (les fils
+ * de réservation l'héritent du père mais ne s'en servent pas).
+ ******************************************************************************/
+
+#ifndef PENDING_REPLIES_H
+#define PENDING_REPLIES_H
+
+#include "common.h"
+
+#define PENDING_RETRY_US 500 // attente entre deux essais, réponses différées en attente
+
+//prototypes de fonctions
+void sendReplyNoWait(const Response *msg_resp);
+void flushPendingReplies();
+void sendPendingReplies();
+bool hasPendingReplies();
+int receiveAndFlush(Request *msg_req, long request_type);
+
+#endif
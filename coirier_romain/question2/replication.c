@@ -0,0 +1,429 @@
+/*******************************************************************************
+ * @file replication.c
+ * @brief Implémentation de la réplication vers un serveur de secours (question 2).
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * cf replication.h
+ * Le journal est écrit sous le sémaphore du segment (un seul écrivain à la fois)
+ * mais lu sans verrou par l'émetteur : chaque entrée est encadrée par son numéro
+ * de séquence (mis à 0 pendant l'écriture), relu après la copie.
+ * Une entrée écrasée par le tour suivant du journal avant d'avoir été émise
+ * provoque l'envoi d'un instantané.
+ ******************************************************************************/
+
+#include "replication.h"
+#include "server.h"
+#include "admission.h"
+#include "handover.h"
+
+#include <poll.h>
+#include <time.h>
+#include <sys/sem.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+// issue de la lecture d'une entrée du journal
+typedef enum {
+    CHANGE_READY,   // entrée copiée
+    CHANGE_PENDING, // pas encore écrite
+    CHANGE_LOST     // déjà écrasée par le tour suivant
+} ChangeStatus;
+
+ReplicationLog *replication_log; // dans le segment partagé (cf attachGenerations())
+
+/**
+ * @brief Inscrit un changement validé dans le journal
+ *
+ * @note à appeler en section critique (sémaphore du segment pris)
+ *
+ * @param show_index l'index du spectacle
+ * @param nb_seats le nouveau nb de places
+ */
+void logChange(int show_index, signed char nb_seats)
+{
+    unsigned long seq = replication_log->next_seq;
+    ChangeRecord *record = &replication_log->records[seq % REPLICATION_LOG_SIZE];
+
+    __atomic_store_n(&record->seq, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    record->show_index = show_index;
+    record->nb_seats = nb_seats;
+    record->type = REPLICATION_CHANGE;
+    __atomic_store_n(&record->seq, seq, __ATOMIC_RELEASE);
+    __atomic_store_n(&replication_log->next_seq, seq + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Lit sans verrou l'entrée de numéro seq du journal
+ */
+static ChangeStatus readChange(unsigned long seq, ChangeRecord *change)
+{
+    unsigned long next_seq = __atomic_load_n(&replication_log->next_seq, __ATOMIC_ACQUIRE);
+    const ChangeRecord *record = &replication_log->records[seq % REPLICATION_LOG_SIZE];
+
+    if (seq >= next_seq)
+    {
+        return CHANGE_PENDING;
+    }
+    if (seq + REPLICATION_LOG_SIZE <= next_seq
+        || __atomic_load_n(&record->seq, __ATOMIC_ACQUIRE) != seq)
+    {
+        return CHANGE_LOST;
+    }
+    change->seq = seq;
+    change->show_index = record->show_index;
+    change->nb_seats = record->nb_seats;
+    change->type = record->type;
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return (__atomic_load_n(&record->seq, __ATOMIC_RELAXED) == seq) ? CHANGE_READY : CHANGE_LOST;
+}
+
+/**
+ * @brief Ecrit entièrement un buffer sur la socket
+ *
+ * @return false si la connexion est perdue
+ */
+static bool writeFull(int fd, const void *buffer, size_t length)
+{
+    const char *data = (const char *)buffer;
+    while (length > 0)
+    {
+        ssize_t written = write(fd, data, length);
+        if (written <= 0)
+        {
+            if (written == -1 && errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        length -= written;
+    }
+    return true;
+}
+
+/**
+ * @brief Lit entièrement un buffer depuis la socket
+ *
+ * @return false si la connexion est perdue
+ */
+static bool readFull(int fd, void *buffer, size_t length)
+{
+    char *data = (char *)buffer;
+    while (length > 0)
+    {
+        ssize_t nb_read = read(fd, data, length);
+        if (nb_read <= 0)
+        {
+            if (nb_read == -1 && errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        data += nb_read;
+        length -= nb_read;
+    }
+    return true;
+}
+
+/**
+ * @brief Indique si le primaire s'est arrêté : segment fermé (Ctrl + c)
+ * ou père du serveur disparu sans le fermer (arrêt brutal, kill -9)
+ *
+ * Le père en service est relu à chaque appel : après une passation
+ * (cf handover.h), l'émission continue pour le nouveau serveur.
+ */
+static bool isPrimaryStopped()
+{
+    return __atomic_load_n(&generations[getNbShows()], __ATOMIC_ACQUIRE) == SEGMENT_CLOSED
+        || !isProcessAlive(__atomic_load_n(&server_stats->server_pid, __ATOMIC_ACQUIRE));
+}
+
+/**
+ * @brief Envoie un instantané cohérent du tableau
+ *
+ * Le tableau et la position dans le journal sont lus dans la même section critique.
+ * Chaque entrée porte le numéro du premier changement postérieur à l'instantané ;
+ * la marque de fin (spectacle -1) le valide côté secours.
+ *
+ * @param fd la socket connectée
+ * @param next_seq reçoit le numéro du premier changement postérieur à l'instantané
+ * @return false si la connexion est perdue
+ */
+static bool sendSnapshot(int fd, unsigned long *next_seq)
+{
+    struct sembuf operations[1];
+    int nb_shows = getNbShows();
+    ChangeRecord *snapshot = (ChangeRecord *)malloc((nb_shows + 1) * sizeof(ChangeRecord));
+    bool sent;
+
+    if (snapshot == NULL)
+    {
+        perror("Echec malloc.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // prélude
+    operations[0].sem_num = RESOURCE_SEM;
+    operations[0].sem_op = -1; // ressource.P()
+    operations[0].sem_flg = 0;
+    semop(semset_id, operations, 1);
+    // section critique
+    *next_seq = replication_log->next_seq;
+    for (int i = 0; i < nb_shows; i++)
+    {
+        snapshot[i].show_index = i;
+        snapshot[i].nb_seats = shows[i].nb_seats;
+    }
+    // postlude
+    operations[0].sem_op = 1; // ressource.V()
+    semop(semset_id, operations, 1);
+
+    // entrées de l'instantané, puis marque de fin
+    for (int i = 0; i <= nb_shows; i++)
+    {
+        snapshot[i].seq = *next_seq;
+        snapshot[i].type = REPLICATION_SNAPSHOT;
+    }
+    snapshot[nb_shows].show_index = -1;
+    snapshot[nb_shows].nb_seats = 0;
+    sent = writeFull(fd, snapshot, (nb_shows + 1) * sizeof(ChangeRecord));
+    free(snapshot);
+    return sent;
+}
+
+/**
+ * @brief Diffuse le journal à un serveur de secours connecté
+ *
+ * @param fd la socket connectée
+ * @param next_seq le prochain numéro attendu par le secours (0 : aucun état)
+ */
+static void streamChanges(int fd, unsigned long next_seq)
+{
+    struct timespec poll_delay = {0, REPLICATION_POLL_US * 1000L};
+    unsigned long log_next = __atomic_load_n(&replication_log->next_seq, __ATOMIC_ACQUIRE);
+    ChangeRecord change;
+
+    // rattrapage depuis le journal si possible, instantané sinon
+    if (next_seq == 0 || next_seq > log_next || next_seq + REPLICATION_LOG_SIZE <= log_next)
+    {
+        printf("%s : Envoi d'un instantane au secours.\n", process_name);
+        if (!sendSnapshot(fd, &next_seq))
+        {
+            return;
+        }
+    }
+    else
+    {
+        printf("%s : Rattrapage du secours depuis le changement %lu.\n", process_name, next_seq);
+    }
+
+    while (!isPrimaryStopped())
+    {
+        switch (readChange(next_seq, &change))
+        {
+            case CHANGE_READY:
+                if (!writeFull(fd, &change, sizeof(ChangeRecord)))
+                {
+                    return;
+                }
+                next_seq++;
+                break;
+            case CHANGE_PENDING:
+                nanosleep(&poll_delay, NULL);
+                break;
+            default: // CHANGE_LOST : le secours a trop de retard
+                printf("%s : Secours en retard, envoi d'un instantane.\n", process_name);
+                if (!sendSnapshot(fd, &next_seq))
+                {
+                    return;
+                }
+        }
+    }
+}
+
+/**
+ * @brief Corps du process d'émission du primaire (ne rend pas la main)
+ *
+ * Ecoute la socket de la partition et sert un secours à la fois.
+ * Se termine quand le serveur ferme le segment ou que son père disparaît.
+ *
+ * @param shard la partition du serveur
+ */
+void runReplicationFeed(int shard)
+{
+    struct sockaddr_un address;
+    struct pollfd listen_poll;
+    struct sigaction sa;
+    int listen_fd;
+
+    // une écriture sur une socket fermée par le secours ne doit pas tuer l'émetteur
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = SIG_IGN;
+    sigaction(SIGPIPE, &sa, NULL);
+
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    snprintf(address.sun_path, sizeof(address.sun_path), REPLICATION_SOCKET_PATH, shard);
+    unlink(address.sun_path);
+    if ((listen_fd = socket(AF_UNIX, SOCK_STREAM, 0)) == -1
+        || bind(listen_fd, (struct sockaddr *)&address, sizeof(address)) == -1
+        || listen(listen_fd, 1) == -1)
+    {
+        perror("Creation de la socket de replication : Echec.\n");
+        exit(EXIT_FAILURE);
+    }
+    printf("%s : Replication ouverte sur %s.\n", process_name, address.sun_path);
+
+    listen_poll.fd = listen_fd;
+    listen_poll.events = POLLIN;
+    while (!isPrimaryStopped())
+    {
+        // attente bornée d'un secours, pour surveiller l'arrêt du primaire
+        if (poll(&listen_poll, 1, REPLICATION_RETRY_MS) <= 0)
+        {
+            continue;
+        }
+        int fd = accept(listen_fd, NULL, NULL);
+        unsigned long next_seq;
+        if (fd == -1)
+        {
+            continue;
+        }
+        if (readFull(fd, &next_seq, sizeof(next_seq)))
+        {
+            printf("%s : Secours connecte.\n", process_name);
+            streamChanges(fd, next_seq);
+            printf("%s : Secours deconnecte.\n", process_name);
+        }
+        close(fd);
+    }
+
+    // le serveur s'arrête : plus d'écoute, le secours peut basculer
+    close(listen_fd);
+    unlink(address.sun_path);
+    printf("%s : Au revoir.\n", process_name);
+    exit(EXIT_SUCCESS);
+}
+
+/**
+ * @brief Se connecte à la socket de réplication du primaire
+ *
+ * @return la socket connectée, -1 si aucun primaire n'écoute
+ */
+static int connectPrimary(int shard)
+{
+    struct sockaddr_un address;
+    int fd;
+
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    snprintf(address.sun_path, sizeof(address.sun_path), REPLICATION_SOCKET_PATH, shard);
+    if ((fd = socket(AF_UNIX, SOCK_STREAM, 0)) == -1)
+    {
+        perror("Creation de la socket de replication : Echec.\n");
+        exit(EXIT_FAILURE);
+    }
+    if (connect(fd, (struct sockaddr *)&address, sizeof(address)) == -1)
+    {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * @brief Suit le primaire jusqu'à sa disparition (serveur de secours)
+ *
+ * Attend le primaire, puis applique ses changements à un tableau privé.
+ * Un instantané est reçu dans un tableau de travail et n'est recopié qu'à sa
+ * marque de fin : une connexion perdue en cours d'instantané laisse l'état précédent.
+ * Une rupture de séquence provoque une reconnexion (rattrapage par le primaire).
+ * Rend la main quand, après une première synchronisation, plus aucun primaire
+ * n'écoute : le secours doit alors basculer.
+ *
+ * @param shard la partition du serveur
+ * @return l'état répliqué
+ */
+ReplicaState followPrimary(int shard)
+{
+    struct timespec retry_delay = {0, REPLICATION_RETRY_MS * 1000000L};
+    int nb_shows = getNbShows();
+    ReplicaState state;
+    ChangeRecord change;
+    signed char *snapshot_seats; // instantané en cours de réception
+    bool synced = false; // un instantané complet a été reçu
+    unsigned long requested_seq;
+    int fd;
+
+    state.seats = (signed char *)calloc(nb_shows, sizeof(signed char));
+    snapshot_seats = (signed char *)calloc(nb_shows, sizeof(signed char));
+    if (state.seats == NULL || snapshot_seats == NULL)
+    {
+        perror("Echec calloc.\n");
+        exit(EXIT_FAILURE);
+    }
+    state.next_seq = 0;
+
+    printf("Secours : attente du primaire de la partition %d...\n", shard);
+    while (1)
+    {
+        if ((fd = connectPrimary(shard)) == -1)
+        {
+            if (synced)
+            {
+                // le primaire a disparu : bascule
+                free(snapshot_seats);
+                return state;
+            }
+            nanosleep(&retry_delay, NULL);
+            continue;
+        }
+        requested_seq = synced ? state.next_seq : 0; // 0 : instantané demandé
+        if (!writeFull(fd, &requested_seq, sizeof(requested_seq)))
+        {
+            close(fd);
+            continue;
+        }
+        printf("Secours : connecte au primaire.\n");
+
+        while (readFull(fd, &change, sizeof(ChangeRecord)))
+        {
+            if (change.show_index >= nb_shows)
+            {
+                fprintf(stderr, "Secours : partition differente du primaire.\n");
+                exit(EXIT_FAILURE);
+            }
+            if (change.type == REPLICATION_SNAPSHOT)
+            {
+                if (change.show_index >= 0)
+                {
+                    snapshot_seats[change.show_index] = change.nb_seats;
+                }
+                else
+                {
+                    // marque de fin : l'instantané complet remplace l'état
+                    memcpy(state.seats, snapshot_seats, nb_shows);
+                    state.next_seq = change.seq;
+                    synced = true;
+                }
+            }
+            else if (synced && change.seq == state.next_seq)
+            {
+                state.seats[change.show_index] = change.nb_seats;
+                state.next_seq++;
+            }
+            else
+            {
+                // rupture de séquence : reconnexion et rattrapage
+                break;
+            }
+        }
+        close(fd);
+        printf("Secours : connexion au primaire perdue (prochain changement %lu).\n", state.next_seq);
+    }
+}
@@ -0,0 +1,66 @@
+/*******************************************************************************
+ * @file replication.h
+ * @brief Réplication du tableau des spectacles vers un serveur de secours (question 2).
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * Chaque réservation validée par bookSeats() est inscrite, dans la même section
+ * critique, dans un journal circulaire du segment partagé : numéro de séquence,
+ * spectacle et nouveau nb de places (valeur absolue, rejouable sans risque).
+ *
+ * Le primaire (option -R) fork un process d'émission qui suit le journal et le
+ * diffuse par une socket locale (REPLICATION_SOCKET_PATH) au serveur de secours.
+ * Il s'arrête avec le primaire : segment fermé, ou père du serveur disparu
+ * (arrêt brutal, kill -9).
+ * Le secours (option -r) applique les changements à son propre tableau, en mémoire
+ * privée. A la connexion, il donne le prochain numéro attendu : le primaire
+ * rattrape depuis le journal si ce numéro y est encore, sinon il envoie
+ * un instantané complet du tableau.
+ *
+ * Quand le primaire disparaît (socket fermée et plus d'écoute), le secours bascule :
+ * il devient serveur avec le tableau répliqué, en reprenant la file de messages
+ * et les outils IPC de la même clef.
+ ******************************************************************************/
+
+#ifndef REPLICATION_H
+#define REPLICATION_H
+
+#include "common.h"
+
+#define REPLICATION_LOG_SIZE 4096 // nb de changements conservés pour le rattrapage
+#define REPLICATION_SOCKET_PATH "/tmp/nsy103_replication_%d" // une socket par partition
+#define REPLICATION_POLL_US 200 // attente de nouveaux changements par l'émetteur
+#define REPLICATION_RETRY_MS 100 // attente du primaire par le secours
+
+#define REPLICATION_CHANGE 0 // changement validé
+#define REPLICATION_SNAPSHOT 1 // entrée d'instantané (show_index -1 : fin de l'instantané)
+
+// Changement du tableau (journal et messages de la socket)
+typedef struct {
+    unsigned long seq; // numéro de séquence (0 dans le journal : écriture en cours ; instantané : premier changement postérieur)
+    int show_index;
+    signed char nb_seats; // nouveau nb de places
+    char type; // REPLICATION_CHANGE, REPLICATION_SNAPSHOT
+} ChangeRecord;
+
+// Journal circulaire (dans le segment partagé, après les compteurs de génération)
+typedef struct {
+    unsigned long next_seq; // numéro du prochain changement (le premier vaut 1)
+    ChangeRecord records[REPLICATION_LOG_SIZE];
+} ReplicationLog;
+
+// Etat répliqué par le secours
+typedef struct {
+    signed char *seats; // nb de places de chaque spectacle de la partition
+    unsigned long next_seq; // prochain numéro attendu
+} ReplicaState;
+
+extern ReplicationLog *replication_log;
+
+//prototypes de fonctions
+void logChange(int show_index, signed char nb_seats);
+void runReplicationFeed(int shard);
+ReplicaState followPrimary(int shard);
+
+#endif
@@ -7,10 +7,24 @@
  *
  * cf common.h
  * Ce serveur fork 1 process lourd fils pour gérer les consultations de façon séquentielle
+ * (par lots : les consultations déjà en attente sont traitées ensemble)
  * Le père gère les réservation de façon parallèle en créant au autre fils pour chaque requête.
  * L'initialisation du server se fait après le fork
  * Les requêtes sont extraites d'une file de messages
  *
+ * Options : -n NB -s N : serveur N (0 à NB - 1) d'un déploiement en NB partitions,
+ * il ne possède que les spectacles de sa partition (cf common.h).
+ * Option -p : placement NUMA de la partition (cf numa_placement.h).
+ * Options -R / -r : primaire diffusant ses changements / serveur de secours
+ * qui les applique et bascule à la disparition du primaire (cf replication.h).
+ * Option -m MAX : nb max de réservations en cours, au delà les requêtes
+ * sont refusées sans fork (cf admission.h) ; statistiques sur SIGUSR1.
+ * Option -c NB : grand catalogue, NB spectacles générés en plus de SHOW_IDS.
+ * Option -H : segment et tas partagés en grandes pages (cf huge_pages.h).
+ * Attente et tenue des sémaphores affichées avec les statistiques (cf lock_profile.h).
+ * Option -U : reprise des outils IPC du serveur en service, qui termine ses requêtes
+ * en cours puis s'arrête sans les supprimer (mise à jour sans interruption, cf handover.h).
+ *
  *
  * @note Chaque process fils attache individuellement le segment de mémoire partagée (table des spectacles)
  * La ressource critique est alors accédée en lecture ou écriture, selon les règles de synchronisation de l'exclusiion mutuelle.
@@ -20,9 +34,20 @@
  ******************************************************************************/
 
 #include "common.h"
+#include "server.h"
+#include "numa_placement.h"
+#include "replication.h"
+#include "admission.h"
+#include "shm_heap.h"
+#include "show_index.h"
+#include "huge_pages.h"
+#include "lock_profile.h"
+#include "handover.h"
+#include "pending_replies.h"
 
 #include <sys/shm.h>
 #include <sys/sem.h>
+#include <getopt.h>
 #include <time.h> // uniquement pour la génération aléatoire de nb de places
 
 // variables globales
@@ -31,20 +56,45 @@ int msg_queue_id; // l'identifiant de la file de messages System V
 int sharedmem_id; // l'identifiant du segment de mémoire partagé
 int semset_id;    // l'identifiant du tableau de sémaphore System V
 Message *shows;   // pointeur vers le futur tableau partagé
+Generation *generations; // compteurs de génération (dans le segment, après le tableau)
+int shard_index = 0; // partition de ce serveur
+int nb_shards = 1;   // nb de partitions du déploiement
+int numa_node = -1;  // noeud NUMA de la partition (-1 : pas de placement)
+bool replication_feed = false; // diffusion des changements au secours
+bool standby = false;          // serveur de secours
+signed char *replicated_seats = NULL; // tableau répliqué, après bascule du secours
+unsigned long replicated_next_seq = 1; // prochain numéro de changement
+int max_in_flight = DEFAULT_MAX_IN_FLIGHT; // nb max de fils de réservation en cours
+volatile sig_atomic_t stats_requested = 0; // SIGUSR1 reçu, affichage à faire
+int catalog_size = 0; // nb de spectacles générés en plus de SHOW_IDS (option -c)
+bool huge_pages = false; // segment et tas en grandes pages (option -H)
+bool handover = false; // reprise des outils IPC d'un serveur en service (option -U)
+volatile sig_atomic_t handover_requested = 0; // SIGUSR2 reçu : un autre serveur reprend la file
 
 // Prototypes
+void parseOptions(int argc, char *argv[]);
+bool isOwnedShow(const char *show_id);
+bool getCatalogShowId(int j, char show_id[SHOW_ID_LEN]);
+
 void sigint_handler(int sig);
+void sigusr1_handler(int sig);
+void sigusr2_handler(int sig);
 
 void setupSignalHandlers();
 void setupSemaphoreSet(key_t key);
 void setupSharedMem(key_t key);
 void populateResource();
-int getNbShows();
+size_t getLogOffset();
+size_t getStatsOffset();
+size_t getSlabOffset();
+size_t getHeapOffset();
+void attachGenerations();
 void setupMsgQueue(key_t key);
 void initServer(key_t key);
 
-void getNbSeats(Message *msg); // consultation
+void getNbSeats(Message *msgs, int nb_msgs); // consultation (par lot)
 void bookSeats(Message *msg);  // réservation
+int receiveRequest(Request *msg_req, long request_type);
 
 /**
  * @brief Crée deux process séparés, un serveur de consultation itératif et un 
@@ -53,23 +103,53 @@ void bookSeats(Message *msg);  // réservation
  * Chaque serveur est initialisé séparément 
  * et chaque process est attaché individuellement au segment de mémoire partagé 
  *
+ * @param argv "-n NB -s N" pour servir la partition N d'un déploiement partitionné,
+ *             "-p" pour la placer sur un noeud NUMA,
+ *             "-R" pour diffuser les changements, "-r" pour un serveur de secours,
+ *             "-m MAX" pour borner le nb de réservations en cours,
+ *             "-c NB" pour un grand catalogue, "-H" pour les grandes pages,
+ *             "-U" pour reprendre les outils IPC du serveur en service
  */
-int main(void)
+int main(int argc, char *argv[])
 {
     printf("PROJET NSY103 - QUESTION 2.\n");
     printf("Serveur.\n");
     printf("===========================\n");
 
     pid_t pid; // pour différencier les processes après un fork()
+    pid_t consult_pid; // serveur de consultation (arrêté par le père lors d'une passation)
     int return_value;
     Request msg_req;
     Response msg_resp;
+    Request consult_reqs[CONSULT_BATCH]; // lot de consultations en attente
+    Message consult_msgs[CONSULT_BATCH];
+
+    parseOptions(argc, argv);
+
+    // épinglage sur le noeud NUMA de la partition, hérité par tous les fils
+    if (numa_node >= 0 && !pinToNumaNode(numa_node))
+    {
+        fprintf(stderr, "Placement sur le noeud NUMA %d impossible.\n", numa_node);
+        numa_node = -1;
+    }
+
+    // serveur de secours : suivi du primaire jusqu'à sa disparition
+    if (standby)
+    {
+        ReplicaState replica = followPrimary(shard_index);
+        printf("Bascule : le secours devient serveur (changement %lu).\n", replica.next_seq);
+        replicated_seats = replica.seats;
+        replicated_next_seq = replica.next_seq;
+    }
 
     // Génération de la clé pour la mémoire partagée et le sémaphore
-    key_t key = ftok(KEY_FILENAME, KEY_ID);
+    // (propre à la partition)
+    key_t key = ftok(KEY_FILENAME, SHARD_KEY_ID(shard_index));
 
     // séparation du serveur en 2 processus lourds
-    pid = fork();
+    initHandOver(handover);
+    fflush(stdout); // rien en attente dans le buffer avant le fork()
+    pid = consult_pid = fork();
     if (pid == 0)
     {
         // processus fils en charge des consultations (mode séquentiel)
@@ -83,24 +163,38 @@ int main(void)
         {
             // on se met en attente d'un message de type REQUEST_CONSULT
             printf("%s : en attente de requetes...\n", process_name);
-            if ((return_value = msgrcv(msg_queue_id, &msg_req,
-             sizeof(Request) - sizeof(long), REQUEST_CONSULT, 0)) == -1)
+            if (receiveRequest(&consult_reqs[0], REQUEST_CONSULT) == -1)
             {
-                perror("Echec msgrcv.\n");
-                exit(EXIT_FAILURE);
+                // passation : les consultations suivantes attendent le nouveau serveur
+                sendPendingReplies();
+                leaveServer();
             }
-            printf("Requete de Consultation pour le spectacle %s.\n", msg_req.msg.show_id);
-
-            //préparation de la réponse
-            msg_resp.msg_type = msg_req.pid; //pid du client pour récupération par le process adéquat
-            strncpy(msg_resp.msg.show_id, msg_req.msg.show_id, SHOW_ID_LEN);
-            getNbSeats(&msg_resp.msg);
-            // envoi de la réponse
-            if ((return_value = msgsnd(msg_queue_id, &msg_resp,
-             sizeof(Response) - sizeof(long), 0)) == -1)
+            // les consultations déjà en attente sont traitées dans le même lot
+            int nb_consults = 1;
+            while (nb_consults < CONSULT_BATCH && msgrcv(msg_queue_id, &consult_reqs[nb_consults],
+                sizeof(Request) - sizeof(long), REQUEST_CONSULT, IPC_NOWAIT) != -1)
             {
-                perror("Echec msgsnd.\n");
-                exit(EXIT_FAILURE);
+                nb_consults++;
+            }
+
+            //préparation des réponses
+            for (int k = 0; k < nb_consults; k++)
+            {
+                printf("Requete de Consultation pour le spectacle %s.\n", consult_reqs[k].msg.show_id);
+                countConsultation();
+                consult_msgs[k] = consult_reqs[k].msg;
+            }
+            getNbSeats(consult_msgs, nb_consults);
+
+            for (int k = 0; k < nb_consults; k++)
+            {
+                msg_resp.msg_type = consult_reqs[k].pid; //pid du client pour récupération par le process adéquat
+                msg_resp.status = STATUS_OK;
+                msg_resp.retry_after_ms = 0;
+                msg_resp.msg = consult_msgs[k];
+                // envoi de la réponse sans attente : seul lecteur des consultations,
+                // le serveur ne doit pas attendre de la place dans la file (cf pending_replies.h)
+                sendReplyNoWait(&msg_resp);
             }
         }
     }
@@ -111,20 +205,50 @@ int main(void)
         // mise en place des gestionnaires de signaux,
         // sémaphore bianire, mémoire partagée et file de messages
         initServer(key);
+        takeOverServer();
+
+        // process d'émission des changements vers le serveur de secours
+        // (celui de l'ancien serveur est gardé en cas de passation)
+        if (replication_feed && !isProcessAlive(server_stats->feed_pid) && fork() == 0)
+        {
+            // petit-fils, détaché du père : la passation n'attend pas sa fin
+            if (fork() != 0)
+            {
+                exit(EXIT_SUCCESS);
+            }
+            strcpy(process_name, "Serveur de replication");
+            __atomic_store_n(&server_stats->feed_pid, getpid(), __ATOMIC_RELEASE);
+            runReplicationFeed(shard_index);
+        }
         
         while (1)
         {
             // on se met en attente d'un message de type REQUEST_RESA
             printf("%s : en attente de requetes...\n", process_name);
-            if ((return_value = msgrcv(msg_queue_id, &msg_req, sizeof(Request) - sizeof(long), REQUEST_RESA, 0)) == -1)
+            if (receiveRequest(&msg_req, REQUEST_RESA) == -1)
             {
-                perror("Echec msgrcv.\n");
-                exit(EXIT_FAILURE);
+                // passation : fin des réservations en cours puis arrêt
+                drainServer(consult_pid);
+            }
+
+            // contrôle d'admission : refus immédiat, sans fork, si le serveur est saturé
+            if (!admitReservation(&msg_req))
+            {
+                msg_resp.msg_type = msg_req.pid;
+                msg_resp.msg = msg_req.msg;
+                msg_resp.status = STATUS_BUSY;
+                msg_resp.retry_after_ms = getRetryAfterMs();
+                // envoi sans attente : une file pleine ne doit pas bloquer le père,
+                // la réponse est alors différée (cf pending_replies.h)
+                sendReplyNoWait(&msg_resp);
+                continue;
             }
             pid = fork();
             if (pid == 0)
             {
                 // process fils
+                // fin de la réservation admise, même sur une sortie en erreur
+                atexit(releaseReservation);
                 sprintf(process_name, "Serveur de reservation N%d", getpid());
                 printf("%s : Requete de Reservation de %d places pour le spectacle %s.\n", process_name, msg_req.msg.nb_seats, msg_req.msg.show_id);
 
@@ -134,6 +258,8 @@ int main(void)
                 //préparation de la réponse
                 msg_resp.msg_type = msg_req.pid;
                 msg_resp.msg = msg_req.msg;
+                msg_resp.status = STATUS_OK;
+                msg_resp.retry_after_ms = 0;
                 bookSeats(&msg_resp.msg);
 
                 // envoi de la réponse
@@ -143,6 +269,7 @@ int main(void)
                     exit(EXIT_FAILURE);
                 }
 
+                releaseReservation();
                 exit(EXIT_SUCCESS);
             }
             // le process père continue d'attendre des requetes dans la queue.
@@ -150,33 +277,243 @@ int main(void)
     }
 }
 
+/**
+ * @brief Attend une requête du type demandé dans la file de messages
+ *
+ * Une attente interrompue par SIGUSR1 affiche les statistiques puis reprend,
+ * par SIGUSR2 (passation, cf handover.h) elle se termine sans requête.
+ *
+ * @param msg_req reçoit la requête
+ * @param request_type le type de requête attendu (REQUEST_CONSULT, REQUEST_RESA)
+ * @return int : la taille du message reçu, -1 si un autre serveur reprend la file
+ */
+int receiveRequest(Request *msg_req, long request_type)
+{
+    int return_value;
+
+    if (handover_requested)
+    {
+        return -1;
+    }
+    // (sans bloquer tant que des réponses attendent de la place dans la file)
+    while ((return_value = receiveAndFlush(msg_req, request_type)) == -1)
+    {
+        if (errno != EINTR)
+        {
+            perror("Echec msgrcv.\n");
+            exit(EXIT_FAILURE);
+        }
+        if (stats_requested)
+        {
+            stats_requested = 0;
+            printServerStats();
+        }
+        if (handover_requested)
+        {
+            return -1;
+        }
+    }
+    return return_value;
+}
+
+/**
+ * @brief Lit les options de la ligne de commande (déploiement partitionné)
+ *
+ * -n NB : nb de partitions (1 à MAX_SHARDS), -s N : partition servie (0 à NB - 1)
+ * -p : placement NUMA, la partition N est servie par le noeud N % nb de noeuds
+ * -R : diffusion des changements, -r : serveur de secours (cf replication.h)
+ * -m MAX : nb max de réservations en cours (cf admission.h)
+ * -c NB : NB spectacles générés en plus de SHOW_IDS (grand catalogue)
+ * -H : segment et tas partagés en grandes pages (cf huge_pages.h)
+ * -U : passation, reprise des outils IPC du serveur en service (cf handover.h)
+ */
+void parseOptions(int argc, char *argv[])
+{
+    int option;
+    bool numa_placement = false;
+
+    while ((option = getopt(argc, argv, "n:s:pRrm:c:HU")) != -1)
+    {
+        switch (option)
+        {
+            case 'n':
+                nb_shards = atoi(optarg);
+                break;
+            case 's':
+                shard_index = atoi(optarg);
+                break;
+            case 'p':
+                numa_placement = true;
+                break;
+            case 'R':
+                replication_feed = true;
+                break;
+            case 'r':
+                standby = true;
+                break;
+            case 'm':
+                max_in_flight = atoi(optarg);
+                break;
+            case 'c':
+                catalog_size = atoi(optarg);
+                break;
+            case 'H':
+                huge_pages = true;
+                break;
+            case 'U':
+                handover = true;
+                break;
+            default:
+                fprintf(stderr, "Usage : %s [-n nb_partitions -s partition] [-p] [-R | -r] [-m max_in_flight] [-c nb_spectacles] [-H] [-U]\n", argv[0]);
+                exit(EXIT_FAILURE);
+        }
+    }
+    if (nb_shards < 1 || nb_shards > MAX_SHARDS || shard_index < 0 || shard_index >= nb_shards)
+    {
+        fprintf(stderr, "Partition %d sur %d non valide (max %d partitions).\n",
+            shard_index, nb_shards, MAX_SHARDS);
+        exit(EXIT_FAILURE);
+    }
+    if (max_in_flight < 1)
+    {
+        fprintf(stderr, "Nb max de reservations en cours non valide.\n");
+        exit(EXIT_FAILURE);
+    }
+    if (catalog_size < 0 || catalog_size > MAX_CATALOG_SIZE)
+    {
+        fprintf(stderr, "Taille de catalogue non valide (max %d).\n", MAX_CATALOG_SIZE);
+        exit(EXIT_FAILURE);
+    }
+    // l'index de la partition doit tenir dans un bloc du tas partagé (cf show_index.h)
+    if (!canIndexShows(getNbShows()))
+    {
+        fprintf(stderr, "Partition de %d spectacles trop grande pour l'index : augmenter le nb de partitions (-n).\n",
+            getNbShows());
+        exit(EXIT_FAILURE);
+    }
+    if (numa_placement)
+    {
+        numa_node = shard_index % getNbNumaNodes();
+    }
+}
+
+/**
+ * @brief Renvoie l'identifiant du j-ième spectacle du catalogue
+ *
+ * Les spectacles de SHOW_IDS, puis les catalog_size spectacles générés :
+ * 'C' suivi du numéro en base 36 sur 5 caractères (C00000, C00001, ...)
+ *
+ * @param j le rang dans le catalogue
+ * @param show_id reçoit l'identifiant
+ * @return bool : false au delà du dernier spectacle
+ */
+bool getCatalogShowId(int j, char show_id[SHOW_ID_LEN])
+{
+    static const char digits[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    static int nb_named = -1;
+
+    if (nb_named < 0)
+    {
+        for (nb_named = 0; SHOW_IDS[nb_named] != NULL; nb_named++);
+    }
+    if (j < nb_named)
+    {
+        memcpy(show_id, SHOW_IDS[j], SHOW_ID_LEN); // 6 caractères et terminaison
+        return true;
+    }
+    if ((j -= nb_named) >= catalog_size)
+    {
+        return false;
+    }
+    show_id[0] = 'C';
+    for (int k = SHOW_ID_LEN - 2; k > 0; k--)
+    {
+        show_id[k] = digits[j % 36];
+        j /= 36;
+    }
+    show_id[SHOW_ID_LEN - 1] = '\0';
+    return true;
+}
+
+/**
+ * @brief Indique si le spectacle appartient à la partition de ce serveur
+ */
+bool isOwnedShow(const char *show_id)
+{
+    return getShowShard(show_id, nb_shards) == shard_index;
+}
+
 /**
  * @brief Gère le signal d'interruption (SIGINT) pour terminer proprement le programme.
  *
- * Libère les ressources : file de message, semaphore, segment de mémoire partagé.
+ * Libère les ressources : file de message, semaphore, segment de mémoire partagé,
+ * sauf si un autre serveur les a reprises (cf handover.h).
  *
  * @param sig Le numéro du signal (non utilisé dans cette fonction).
  */
 void sigint_handler(int sig)
 {
+    if (isHandedOver())
+    {
+        leaveServer();
+    }
     printf("\n");
+    removeIpcResources();
+    printf("%s : Au revoir.\n", process_name);
+    exit(EXIT_SUCCESS);
+}
+
+/**
+ * @brief Supprime les outils IPC du serveur : file de message, semaphore,
+ * extensions du tas, segment de mémoire partagé (détaché)
+ */
+void removeIpcResources()
+{
     printf("%s : Suppression de la queue.\n", process_name);
     msgctl(msg_queue_id, IPC_RMID, NULL);
     printf("%s : Suppression du semaphore.\n", process_name);
     semctl(semset_id, 0, IPC_RMID, 0);
+    printf("%s : Suppression des extensions du tas partage.\n", process_name);
+    destroyShmHeap();
+    // signale aux clients en lecture locale que le segment n'est plus maintenu
+    __atomic_store_n(&generations[getNbShows()], SEGMENT_CLOSED, __ATOMIC_RELEASE);
     printf("%s : Détachement du segment de mémoire partagé.\n", process_name);
     shmdt(shows);
     printf("%s : Suppression du segment partagé.\n", process_name);
     shmctl(sharedmem_id, IPC_RMID, NULL);
+}
 
-    printf("%s : Au revoir.\n", process_name);
-    exit(EXIT_SUCCESS);
+/**
+ * @brief Gère le signal SIGUSR1 : demande d'affichage des statistiques
+ *
+ * L'affichage est fait par la boucle de réception (cf receiveRequest()),
+ * dont l'attente dans msgrcv est interrompue par le signal.
+ *
+ * @param sig Le numéro du signal (non utilisé dans cette fonction).
+ */
+void sigusr1_handler(int sig)
+{
+    stats_requested = 1;
+}
+
+/**
+ * @brief Gère le signal SIGUSR2 : un nouveau serveur reprend les outils IPC
+ *
+ * L'arrêt est fait par la boucle de réception (cf receiveRequest()),
+ * dont l'attente dans msgrcv est interrompue par le signal.
+ *
+ * @param sig Le numéro du signal (non utilisé dans cette fonction).
+ */
+void sigusr2_handler(int sig)
+{
+    handover_requested = 1;
 }
 
 /**
  * @brief Mets en place les handlers de signaux
  * 
- * Déclare un handler pour le signal d'interruption
+ * Déclare un handler pour le signal d'interruption,
+ *  un pour la demande de statistiques, un pour la passation
  *  et ignore le signal de mort des enfants
  * 
  * @note les enfants zombies seront gérés par le systeme d'exploitation
@@ -195,6 +532,26 @@ void setupSignalHandlers()
         exit(EXIT_FAILURE);
     }
 
+    // demande de statistiques, sans SA_RESTART pour interrompre msgrcv
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = sigusr1_handler;
+    sa.sa_flags = 0;
+    if (sigaction(SIGUSR1, &sa, NULL) == -1)
+    {
+        perror("Erreur sigaction.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // passation, sans SA_RESTART pour interrompre msgrcv
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = sigusr2_handler;
+    sa.sa_flags = 0;
+    if (sigaction(SIGUSR2, &sa, NULL) == -1)
+    {
+        perror("Erreur sigaction.\n");
+        exit(EXIT_FAILURE);
+    }
+
     // pas de handler pour sigchld :
     // les enfants zombis seront gérés par l'OS
     memset(&sa, 0, sizeof(sa));
@@ -211,7 +568,7 @@ void setupSignalHandlers()
  * @brief Initialise un server (appelé par le server de consult ET le server de résa).
  * 
  * Configure les handlers de signaux, le sémaphore,
- * le segment de mémoire partagée et la file de messages
+ * la file de messages et le segment de mémoire partagée
  * 
  * @note : le premier process à créer le segement partagé 
  * est aussi en charge de créer le tableau des données.
@@ -226,18 +583,26 @@ void initServer(key_t key)
     // mise en place du tableau des sémaphores
     setupSemaphoreSet(key);
 
-    // mise en place / récupération du segment de mémoire partagé
-    setupSharedMem(key);
-    
     // Création / récupération de la message queue
+    // (avant le segment : supprimée avec lui si le remplissage échoue)
     setupMsgQueue(key);
 
+    // mise en place / récupération du segment de mémoire partagé
+    setupSharedMem(key);
+
     setbuf(stdout, NULL);
+    printf("%s : Partition %d sur %d.\n", process_name, shard_index, nb_shards);
+    if (numa_node >= 0)
+    {
+        printf("%s : Noeud NUMA %d.\n", process_name, numa_node);
+    }
+    initAdmission(max_in_flight);
     printf("%s : 'Ctrl + c' pour mettre fin au programme.\n", process_name);
+    printf("%s : 'kill -USR1 %d' pour afficher les statistiques.\n", process_name, getpid());
 }
 
 /**
- * @brief Crée/récupère un tableau de 1 sémaphore et l'initie à 1 (sémaphore binaire)
+ * @brief Crée/récupère un tableau de NB_SEMS sémaphores (ressource, tas partagé) et les initie à 1 (sémaphores binaires)
  * 
  * Utilise la clef en paragmètre pour identifier le sémaphore.
  * Si la tentative de création échoue, alors on tente une récupération
@@ -246,15 +611,18 @@ void initServer(key_t key)
  * @param key_t la clef identifiant l'outil IPC
  */
 void setupSemaphoreSet(key_t key) {
-    // Création d'un tableau de 1 semaphore
-    if ((semset_id = semget(key, 1, IPC_CREAT | IPC_EXCL | 0666)) == -1)
+    bool created = true;
+
+    // Création d'un tableau de NB_SEMS semaphores
+    if ((semset_id = semget(key, NB_SEMS, IPC_CREAT | IPC_EXCL | 0666)) == -1)
     {
         // la création a échoué
         if (errno == EEXIST)
         {
             //le tableau de semaphore existe déjà, on le récupère
             printf("%s : Recuperation du tableau des semaphores.\n", process_name);
-            semset_id = semget(key, 1, 0666);            
+            semset_id = semget(key, NB_SEMS, 0666);            
+            created = false;
         }
         else
         {
@@ -266,8 +634,14 @@ void setupSemaphoreSet(key_t key) {
     } else {
         printf("%s : Creation du tableau des semaphores : Succes.\n", process_name);
     }    
-    // Initialisation du semaphore (index 0, valeur d'init : 1)
-    semctl(semset_id, 0, SETVAL, 1);
+    if (handover && !created)
+    {
+        // passation : les sémaphores peuvent être pris par l'ancien serveur
+        return;
+    }
+    // Initialisation des semaphores (ressource et tas, valeur d'init : 1)
+    semctl(semset_id, RESOURCE_SEM, SETVAL, 1);
+    semctl(semset_id, HEAP_SEM, SETVAL, 1);
 }
 
 /**
@@ -284,8 +658,10 @@ void setupSemaphoreSet(key_t key) {
 void setupSharedMem(key_t key)
 {
     // mise en place du segment de mémoire partagée
+    // (tableau des spectacles suivi des compteurs de génération, du journal de réplication,
+    // des compteurs du serveur, des fiches de réservation et de l'en-tête du tas partagé)
     size_t shm_size;
-    shm_size = (getNbShows() + 1) * sizeof(Message);
+    shm_size = getHeapOffset() + sizeof(ShmHeap);
 
     // récupération du segment de mémoire partagée
     if ((sharedmem_id = shmget(key, shm_size, 0666)) == -1)
@@ -296,13 +672,25 @@ void setupSharedMem(key_t key)
         {
             // le segment n'existe pas encore, => on le crée
             printf("%s : Creation du segment de memoire partage.\n", process_name);
-            sharedmem_id = shmget(key, shm_size, 0666 | IPC_CREAT);
+            sharedmem_id = createHugeSegment(key, shm_size, huge_pages);
             // attachement du segment créé à l'espace d'adressage du process
             if ((shows = (Message *)shmat(sharedmem_id, NULL, 0)) == (Message *)-1)
             {
                 perror("Erreur lors de l attachement a la memoire partagee");
                 exit(EXIT_FAILURE);
             }
+            if (huge_pages)
+            {
+                adviseHugePages(shows, shm_size);
+            }
+            // allocation sur le noeud de la partition, avant le premier accès
+            if (numa_node >= 0)
+            {
+                bindToNumaNode(shows, shm_size, numa_node);
+            }
+            attachGenerations();
+            initShmSlab(shows, getSlabOffset(), sizeof(ReservationRecord), RESERVATION_RECORDS);
+            initShmHeap(huge_pages);
             // instanciation du tableau des spectacles
             populateResource();
         }
@@ -325,16 +713,82 @@ void setupSharedMem(key_t key)
         } else {
             printf("%s : Segment de memoire partage attache.\n", process_name);
         }
+        if (huge_pages)
+        {
+            adviseHugePages(shows, shm_size);
+        }
+        attachGenerations();
     }
 }
 
+/**
+ * @brief Renvoie la position du journal de réplication dans le segment
+ * 
+ * Le journal suit les compteurs de génération, aligné pour ses numéros de séquence.
+ */
+size_t getLogOffset()
+{
+    size_t offset = (getNbShows() + 1) * (sizeof(Message) + sizeof(Generation));
+    return (offset + __alignof__(ReplicationLog) - 1) & ~(__alignof__(ReplicationLog) - 1);
+}
+
+/**
+ * @brief Renvoie la position des compteurs du serveur dans le segment
+ * 
+ * Ils suivent le journal de réplication, alignés.
+ */
+size_t getStatsOffset()
+{
+    size_t offset = getLogOffset() + sizeof(ReplicationLog);
+    return (offset + __alignof__(ServerStats) - 1) & ~(__alignof__(ServerStats) - 1);
+}
+
+/**
+ * @brief Renvoie la position de la réserve des fiches de réservation dans le segment
+ * 
+ * Elle suit les compteurs du serveur, alignée.
+ */
+size_t getSlabOffset()
+{
+    size_t offset = getStatsOffset() + sizeof(ServerStats);
+    return (offset + __alignof__(ShmSlab) - 1) & ~(__alignof__(ShmSlab) - 1);
+}
+
+/**
+ * @brief Renvoie la position de l'en-tête du tas partagé dans le segment
+ * 
+ * Il suit la réserve des fiches de réservation, aligné.
+ */
+size_t getHeapOffset()
+{
+    size_t offset = getSlabOffset() + getShmSlabSize(sizeof(ReservationRecord), RESERVATION_RECORDS);
+    return (offset + __alignof__(ShmHeap) - 1) & ~(__alignof__(ShmHeap) - 1);
+}
+
+/**
+ * @brief Positionne les pointeurs des compteurs de génération, du journal,
+ * des compteurs du serveur, des fiches de réservation et du tas dans le segment attaché
+ * 
+ * Les compteurs suivent directement le tableau des spectacles (terminaison comprise).
+ */
+void attachGenerations()
+{
+    generations = (Generation *)(shows + getNbShows() + 1);
+    replication_log = (ReplicationLog *)((char *)shows + getLogOffset());
+    server_stats = (ServerStats *)((char *)shows + getStatsOffset());
+    reservation_slab = (ShmSlab *)shmPointer(shows, getSlabOffset());
+    shm_heap = (ShmHeap *)shmPointer(shows, getHeapOffset());
+}
+
 /**
  * @brief Remplit la resource partagée shows[] avec les données des spectacle
  * 
  * l'accès en écriture à la ressource est protégé par un sémaphore en exclusion mutuelle
  * 
  * @note le nombre de places est décidé au hasard entre 16 et 30
+ * (ou repris du tableau répliqué après la bascule d'un secours)
  * un indicateur de fin de tableau est signifié par tous les bits de la structure à 0
+ * seuls les spectacles de la partition du serveur sont chargés
  */
 void populateResource()
 {
@@ -351,14 +805,25 @@ void populateResource()
     // instanciation du tableau des spectacles
     
         int i = 0;
-        while (SHOW_IDS[i] != NULL)
+        char show_id[SHOW_ID_LEN];
+        for (int j = 0; getCatalogShowId(j, show_id); j++)
         {
-            strncpy(shows[i].show_id, SHOW_IDS[i], SHOW_ID_LEN);
-            shows[i].nb_seats = 16 + rand() % 15;
+            if (!isOwnedShow(show_id))
+            {
+                continue;
+            }
+            memcpy(shows[i].show_id, show_id, SHOW_ID_LEN);
+            shows[i].nb_seats = (replicated_seats != NULL) ? replicated_seats[i] : 16 + rand() % 15;
+            generations[i] = 0;
             i++;
         }
         // terminaison du tableau
-        memset(&shows[++i], 0, sizeof(Message));
+        memset(&shows[i], 0, sizeof(Message));
+        __atomic_store_n(&generations[i], SEGMENT_OPEN, __ATOMIC_RELEASE);
+        // index des spectacles, dans le tas partagé
+        buildShowIndex(i);
+        // journal de réplication vide, numérotation reprise en cas de bascule
+        replication_log->next_seq = replicated_next_seq;
     // Sortie de section critique
 
     // postlude
@@ -368,22 +833,31 @@ void populateResource()
 }
 
 /**
- * @brief Renvoie le nombre d'entrée du tableau des identifiants de spectacles
- * défini dans le ficheir de header
+ * @brief Renvoie le nombre de spectacles du catalogue (cf getCatalogShowId())
+ * appartenant à la partition du serveur
  * 
- * note : On utilise NULL pour signifier la fin des entrées
+ * note : le compte est fait au premier appel (hérité par les fils)
  *
- * @return int : la longeur du tableau
+ * @return int : la longeur du tableau de la partition
  */
 int getNbShows()
 {
-    int i = 0;
-    // on compte la taille du tableau des noms de spectacles
-    while (SHOW_IDS[i] != NULL)
+    static int nb_shows = -1;
+    char show_id[SHOW_ID_LEN];
+
+    if (nb_shows < 0)
     {
-        i++;
+        // on compte les spectacles de la partition
+        nb_shows = 0;
+        for (int j = 0; getCatalogShowId(j, show_id); j++)
+        {
+            if (isOwnedShow(show_id))
+            {
+                nb_shows++;
+            }
+        }
     }
-    return i;
+    return nb_shows;
 }
 
 /**
@@ -410,40 +884,48 @@ void setupMsgQueue(key_t key) {
 }
 
 /**
- * @brief retourne le nb de place d'un spectacle passé en paramètre
+ * @brief retourne le nb de places des spectacles d'un lot de consultations
  * 
- * l'accès en lecture à la ressource est protégé par un sémaphore binaire (mutex)
+ * l'accès en lecture à la ressource est protégé par un sémaphore binaire (mutex),
+ * pris une seule fois pour tout le lot
  * 
- * note : la partie recherche d'index est hors de la section critique
+ * note : la recherche des index (vectorisée, par lot, cf show_index.h)
+ * est hors de la section critique
  * 
- * @param Message* un pointeur qui va recevoir le nb de places
+ * @param msgs les messages qui vont recevoir le nb de places
+ * (tous les bits à 0 pour un spectacle inconnu)
+ * @param nb_msgs le nb de messages du lot (au plus CONSULT_BATCH)
  */
-void getNbSeats(Message *msg)
+void getNbSeats(Message *msgs, int nb_msgs)
 {
     struct sembuf operations[1];
-    // recherche de l'index du spectacle
-    bool found = false;
-    int i = -1;
-    while (!found && (shows[++i].show_id[0] != '\0'))
-    {
-        found = strcmp(msg->show_id, shows[i].show_id) == 0;
-    }
-    if (!found)
-    {
-        // le spectacle demandé n'a pas été trouvé dans la liste
-        // on met tous les bits du message à 0 pour le signifier
-        memset(msg, 0, sizeof(Message));
-        return;
-    }
+    LockTiming timing;
+    int indexes[CONSULT_BATCH];
+
+    // recherche des index des spectacles
+    findShows(msgs, nb_msgs, indexes);
 
     // accès en lecture au segment partagé
 
     // prélude
     operations[0].sem_num = RESOURCE_SEM;
     operations[0].sem_op = -1; // ressource.P()
-    semop(semset_id, operations, 1);
+    operations[0].sem_flg = 0;
+    beginLockWait(&timing);
+    lockAcquired(&timing, semopContended(operations, 1));
     // section critique
-    msg->nb_seats = shows[i].nb_seats;
+    for (int k = 0; k < nb_msgs; k++)
+    {
+        if (indexes[k] < 0)
+        {
+            // le spectacle demandé n'a pas été trouvé dans la liste
+            // on met tous les bits du message à 0 pour le signifier
+            memset(&msgs[k], 0, sizeof(Message));
+            continue;
+        }
+        msgs[k].nb_seats = shows[indexes[k]].nb_seats;
+    }
+    lockReleased(&timing, LOCK_CONSULT, LOCK_BATCH_SHOW);
     // postlude
     operations[0].sem_num = RESOURCE_SEM;
     operations[0].sem_op = 1; // ressource.V()
@@ -457,6 +939,8 @@ void getNbSeats(Message *msg)
  * vérifie si la requete est possible (nb places restantes >= nb de places demandées)
  * 
  * l'accès en écriture à la ressource est protégé est protégé par un sémaphore binaire (mutex)
+ * chaque modification incrémente le compteur de génération du spectacle (cf common.h)
+ * et est inscrite au journal de réplication (cf replication.h)
  * 
  * note : la partie recherche d'index est hors de la section critique
  * 
@@ -466,14 +950,10 @@ void getNbSeats(Message *msg)
 void bookSeats(Message *msg)
 {
     struct sembuf operations[1];
-    // recherche de l'index du spectacle
-    bool found = false;
-    int i = -1;
-    while (!found && (shows[++i].show_id[0] != '\0'))
-    {
-        found = strcmp(msg->show_id, shows[i].show_id) == 0;
-    }
-    if (!found)
+    LockTiming timing;
+    // recherche de l'index du spectacle (cf show_index.h)
+    int i = findShow(msg->show_id);
+    if (i < 0)
     {
         // le spectacle demandé n'a pas été trouvé dans la liste
         // on met tous les bits du message à 0 pour le signifier
@@ -486,18 +966,28 @@ void bookSeats(Message *msg)
     // prélude
     operations[0].sem_num = RESOURCE_SEM;
     operations[0].sem_op = -1; // ressource.P()
-    semop(semset_id, operations, 1);
+    operations[0].sem_flg = 0;
+    beginLockWait(&timing);
+    lockAcquired(&timing, semopContended(operations, 1));
     // section critique
     if (msg->nb_seats <= shows[i].nb_seats)
     {
         // il reste assez de places
-        shows[i].nb_seats = shows[i].nb_seats - msg->nb_seats;
+        // écriture encadrée par le compteur de génération (impair pendant l'écriture)
+        // pour les clients qui lisent le segment sans passer par le sémaphore
+        Generation generation = generations[i];
+        __atomic_store_n(&generations[i], generation + 1, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        __atomic_store_n(&shows[i].nb_seats, shows[i].nb_seats - msg->nb_seats, __ATOMIC_RELAXED);
+        __atomic_store_n(&generations[i], generation + 2, __ATOMIC_RELEASE);
+        logChange(i, shows[i].nb_seats);
     }
     else
     {
         // il ne reste pas assez de places pour honorer la réservation entière
         msg->nb_seats = -1 * shows[i].nb_seats;
     }
+    lockReleased(&timing, LOCK_BOOK, i);
     // postlude
     operations[0].sem_num = RESOURCE_SEM;
     operations[0].sem_op = 1; // ressource.V()
@@ -0,0 +1,31 @@
+/*******************************************************************************
+ * @file server.h
+ * @brief Déclarations du serveur de la question 2 partagées avec ses modules.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * cf server.c
+ * Accès au segment partagé (tableau des spectacles, compteurs de génération)
+ * et au sémaphore binaire qui le protège.
+ ******************************************************************************/
+
+#ifndef SERVER_H
+#define SERVER_H
+
+#include "common.h"
+
+#define CONSULT_BATCH 32 // nb max de consultations traitées ensemble
+
+// variables globales (définies dans server.c)
+extern char process_name[30];
+extern int msg_queue_id;
+extern int semset_id;
+extern Message *shows;
+extern Generation *generations;
+
+//prototypes de fonctions
+int getNbShows();
+void removeIpcResources();
+
+#endif
@@ -0,0 +1,260 @@
+/*******************************************************************************
+ * @file shm_heap.c
+ * @brief Implémentation du tas partagé extensible de la question 2.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * cf shm_heap.h
+ * Chaque bloc commence par un en-tête de 16 octets (classe de taille),
+ * un bloc libre garde dans ses données le pointeur relatif du bloc libre suivant.
+ * Les extensions ne sont jamais détachées avant la fin du process.
+ ******************************************************************************/
+
+#include "shm_heap.h"
+#include "server.h"
+#include "huge_pages.h"
+#include "lock_profile.h"
+
+#include <sys/shm.h>
+#include <sys/sem.h>
+
+#define BLOCK_HEADER 16
+#define HEAP_EXTENT(block) ((unsigned int)((block) >> 40) - 1)
+#define HEAP_POSITION(block) ((size_t)((block) & ((1UL << 40) - 1)))
+#define HEAP_PTR(extent, position) ((((ShmHeapPtr)(extent) + 1) << 40) | (position))
+
+typedef struct {
+    unsigned int size_class;
+    unsigned int allocated;
+} BlockHeader;
+
+ShmHeap *shm_heap; // dans le segment principal (cf attachGenerations())
+
+// variables du module (propres au process)
+static char *extents[SHM_HEAP_MAX_EXTENTS]; // adresses d'attachement des extensions
+static unsigned int nb_attached; // génération connue du process
+static LockTiming heap_timing; // section critique en cours (cf lock_profile.h)
+
+/**
+ * @brief Prise / libération du sémaphore du tas (mesurée, cf lock_profile.h)
+ *
+ * @param op -1 : P(), 1 : V()
+ */
+static void heapLock(int op)
+{
+    struct sembuf operations[1];
+
+    operations[0].sem_num = HEAP_SEM;
+    operations[0].sem_op = op;
+    operations[0].sem_flg = 0;
+    if (op < 0)
+    {
+        beginLockWait(&heap_timing);
+        lockAcquired(&heap_timing, semopContended(operations, 1));
+        return;
+    }
+    lockReleased(&heap_timing, LOCK_HEAP, LOCK_BATCH_SHOW);
+    while (semop(semset_id, operations, 1) == -1)
+    {
+        if (errno != EINTR)
+        {
+            perror("Echec semop.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+}
+
+/**
+ * @brief Attache les extensions créées depuis la dernière synchronisation
+ */
+static void syncExtents()
+{
+    unsigned int nb_extents = __atomic_load_n(&shm_heap->nb_extents, __ATOMIC_ACQUIRE);
+
+    while (nb_attached < nb_extents)
+    {
+        char *address = (char *)shmat(shm_heap->extent_ids[nb_attached], NULL, 0);
+        if (address == (char *)-1)
+        {
+            perror("Erreur lors de l attachement d'une extension du tas");
+            exit(EXIT_FAILURE);
+        }
+        if (shm_heap->huge_pages)
+        {
+            adviseHugePages(address, shm_heap->extent_sizes[nb_attached]);
+        }
+        extents[nb_attached++] = address;
+    }
+}
+
+/**
+ * @brief Ajoute une extension d'au moins size octets (sous HEAP_SEM)
+ *
+ * @return bool : false si le tas a atteint son nb max d'extensions
+ */
+static bool growHeap(size_t size)
+{
+    unsigned int extent = shm_heap->nb_extents;
+    size_t extent_size = (size_t)SHM_HEAP_FIRST_EXTENT << extent;
+    int id;
+
+    if (extent == SHM_HEAP_MAX_EXTENTS)
+    {
+        return false;
+    }
+    while (extent_size < size)
+    {
+        extent_size *= 2;
+    }
+    if ((id = createHugeSegment(IPC_PRIVATE, extent_size, shm_heap->huge_pages)) == -1)
+    {
+        return false;
+    }
+    shm_heap->extent_ids[extent] = id;
+    shm_heap->extent_sizes[extent] = extent_size;
+    shm_heap->extent_used = 0;
+    // publication de la nouvelle génération
+    __atomic_store_n(&shm_heap->nb_extents, extent + 1, __ATOMIC_RELEASE);
+    printf("%s : Extension %u du tas partage (%zu Ko).\n", process_name, extent, extent_size / 1024);
+    return true;
+}
+
+/**
+ * @brief Prépare un tas vide, sans extension (créateur du segment)
+ *
+ * @param huge_pages true : extensions en grandes pages
+ */
+void initShmHeap(bool huge_pages)
+{
+    memset(shm_heap, 0, sizeof(ShmHeap));
+    shm_heap->huge_pages = huge_pages;
+    nb_attached = 0;
+}
+
+/**
+ * @brief Alloue un bloc dans le tas
+ *
+ * @param size la taille demandée (au plus SHM_HEAP_MAX_ALLOC octets)
+ * @return ShmHeapPtr le bloc (non initialisé), SHM_HEAP_NULL si le tas est plein
+ */
+ShmHeapPtr shmHeapAlloc(size_t size)
+{
+    unsigned int size_class = 0;
+    size_t block_size = SHM_HEAP_MIN_BLOCK;
+    ShmHeapPtr block;
+
+    while (block_size < size + BLOCK_HEADER)
+    {
+        if (++size_class == SHM_HEAP_NB_CLASSES)
+        {
+            return SHM_HEAP_NULL;
+        }
+        block_size *= 2;
+    }
+
+    heapLock(-1);
+    if ((block = shm_heap->free_blocks[size_class]) != SHM_HEAP_NULL)
+    {
+        // réutilisation d'un bloc libéré
+        shm_heap->free_blocks[size_class] = *(ShmHeapPtr *)((char *)shmHeapPointer(block) + BLOCK_HEADER);
+    }
+    else
+    {
+        unsigned int extent = shm_heap->nb_extents - 1;
+        if (shm_heap->nb_extents == 0
+            || shm_heap->extent_used + block_size > shm_heap->extent_sizes[extent])
+        {
+            // la fin de l'extension courante est abandonnée
+            if (!growHeap(block_size))
+            {
+                heapLock(1);
+                return SHM_HEAP_NULL;
+            }
+            extent = shm_heap->nb_extents - 1;
+        }
+        block = HEAP_PTR(extent, shm_heap->extent_used);
+        shm_heap->extent_used += block_size;
+    }
+    shm_heap->nb_allocated += block_size;
+    heapLock(1);
+
+    BlockHeader *header = (BlockHeader *)shmHeapPointer(block);
+    header->size_class = size_class;
+    header->allocated = 1;
+    return block + BLOCK_HEADER;
+}
+
+/**
+ * @brief Rend un bloc alloué par shmHeapAlloc() à sa classe
+ *
+ * @param block le bloc, qui ne doit plus être utilisé (SHM_HEAP_NULL : rien)
+ */
+void shmHeapFree(ShmHeapPtr block)
+{
+    if (block == SHM_HEAP_NULL)
+    {
+        return;
+    }
+    block -= BLOCK_HEADER;
+    BlockHeader *header = (BlockHeader *)shmHeapPointer(block);
+
+    heapLock(-1);
+    header->allocated = 0;
+    *(ShmHeapPtr *)((char *)header + BLOCK_HEADER) = shm_heap->free_blocks[header->size_class];
+    shm_heap->free_blocks[header->size_class] = block;
+    shm_heap->nb_allocated -= (size_t)SHM_HEAP_MIN_BLOCK << header->size_class;
+    heapLock(1);
+}
+
+/**
+ * @brief Adresse d'un bloc du tas dans le process courant
+ *
+ * Attache au besoin les extensions créées par d'autres process.
+ *
+ * @param block le bloc (SHM_HEAP_NULL : NULL)
+ */
+void *shmHeapPointer(ShmHeapPtr block)
+{
+    unsigned int extent;
+
+    if (block == SHM_HEAP_NULL)
+    {
+        return NULL;
+    }
+    extent = HEAP_EXTENT(block);
+    if (extent >= nb_attached)
+    {
+        syncExtents();
+    }
+    return extents[extent] + HEAP_POSITION(block);
+}
+
+/**
+ * @brief Supprime les extensions du tas (fin du serveur)
+ */
+void destroyShmHeap()
+{
+    unsigned int nb_extents = __atomic_load_n(&shm_heap->nb_extents, __ATOMIC_ACQUIRE);
+
+    for (unsigned int i = 0; i < nb_extents; i++)
+    {
+        shmctl(shm_heap->extent_ids[i], IPC_RMID, NULL);
+    }
+}
+
+/**
+ * @brief Affiche l'occupation du tas
+ */
+void printShmHeapStats()
+{
+    unsigned int nb_extents = __atomic_load_n(&shm_heap->nb_extents, __ATOMIC_ACQUIRE);
+    size_t total = 0;
+
+    for (unsigned int i = 0; i < nb_extents; i++)
+    {
+        total += shm_heap->extent_sizes[i];
+    }
+    printf("Tas partage : %u extensions (%zu Ko), %zu Ko alloues, %u attachees par ce process.\n",
+        nb_extents, total / 1024, shm_heap->nb_allocated / 1024, nb_attached);
+}
@@ -0,0 +1,74 @@
+/*******************************************************************************
+ * @file shm_heap.h
+ * @brief Tas partagé extensible du serveur de la question 2.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * Le segment principal a une taille fixée à sa création : les structures
+ * dynamiques partagées (index, tables, files) sont allouées dans un tas
+ * fait d'extensions, segments System V supplémentaires créés à la demande
+ * (IPC_PRIVATE) et de tailles croissantes (SHM_HEAP_FIRST_EXTENT, puis le double
+ * de la précédente). L'en-tête du tas (ShmHeap) est dans le segment principal.
+ *
+ * Un bloc est désigné par un pointeur relatif ShmHeapPtr (numéro d'extension
+ * et position dans l'extension), valable dans tous les process ; shmHeapPointer()
+ * le convertit en adresse pour le process courant.
+ *
+ * Poignée de main de génération : le nb d'extensions (nb_extents) est la
+ * génération du tas. Chaque process garde ses propres attachements ; un pointeur
+ * vers une extension qu'il n'a pas encore attachée lui fait relire la génération
+ * et attacher les nouvelles extensions, sans arrêt ni copie pour les autres process.
+ *
+ * Les blocs sont rangés par classes de tailles (puissances de 2, de SHM_HEAP_MIN_BLOCK
+ * à SHM_HEAP_MAX_BLOCK) ; un bloc libéré est réutilisé par la même classe.
+ * Allocation et libération sont protégées par le sémaphore HEAP_SEM.
+ *
+ * Avec l'option -H du serveur, les extensions sont en grandes pages (cf huge_pages.h).
+ *
+ * Des racines nommées (roots[]) permettent de retrouver les structures du tas
+ * (SHM_ROOT_SHOW_INDEX : index des spectacles, cf show_index.h).
+ ******************************************************************************/
+
+#ifndef SHM_HEAP_H
+#define SHM_HEAP_H
+
+#include "common.h"
+
+#define SHM_HEAP_MAX_EXTENTS 24 // nb max d'extensions
+#define SHM_HEAP_FIRST_EXTENT (1024 * 1024) // taille de la première extension
+#define SHM_HEAP_MIN_BLOCK 16 // plus petite classe de blocs (en-tête compris)
+#define SHM_HEAP_NB_CLASSES 24 // classes de 16 o à 128 Mo
+#define SHM_HEAP_MAX_BLOCK ((size_t)SHM_HEAP_MIN_BLOCK << (SHM_HEAP_NB_CLASSES - 1))
+#define SHM_HEAP_MAX_ALLOC (SHM_HEAP_MAX_BLOCK - 16) // plus grande allocation (en-tête de bloc déduit)
+#define SHM_HEAP_NULL 0UL
+
+// Racines du tas
+#define SHM_ROOT_SHOW_INDEX 0
+#define SHM_HEAP_NB_ROOTS 4
+
+typedef unsigned long ShmHeapPtr; // ((extension + 1) << 40) | position dans l'extension
+
+// En-tête du tas (dans le segment principal)
+typedef struct {
+    unsigned int nb_extents; // génération du tas
+    int extent_ids[SHM_HEAP_MAX_EXTENTS]; // identifiants System V des extensions
+    size_t extent_sizes[SHM_HEAP_MAX_EXTENTS];
+    size_t extent_used; // remplissage de la dernière extension
+    ShmHeapPtr free_blocks[SHM_HEAP_NB_CLASSES]; // blocs libérés, par classe
+    size_t nb_allocated; // octets alloués (blocs entiers)
+    ShmHeapPtr roots[SHM_HEAP_NB_ROOTS];
+    bool huge_pages; // extensions en grandes pages (cf huge_pages.h)
+} ShmHeap;
+
+extern ShmHeap *shm_heap;
+
+//prototypes de fonctions
+void initShmHeap(bool huge_pages);
+ShmHeapPtr shmHeapAlloc(size_t size);
+void shmHeapFree(ShmHeapPtr block);
+void *shmHeapPointer(ShmHeapPtr block);
+void destroyShmHeap();
+void printShmHeapStats();
+
+#endif
@@ -0,0 +1,183 @@
+/*******************************************************************************
+ * @file shm_slab.c
+ * @brief Implémentation de l'allocateur d'objets du segment partagé (question 2).
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * cf shm_slab.h
+ * Un objet libre commence par l'index + 1 de l'objet libre suivant (0 : fin).
+ * Le compteur de modifications du sommet de pile fait échouer le
+ * compare-and-swap d'un process qui aurait lu un sommet depuis repris et rendu.
+ ******************************************************************************/
+
+#include "shm_slab.h"
+
+#include <stddef.h>
+
+#define FREE_INDEX(top) ((unsigned int)((top) & 0xFFFFFFFFUL))
+#define FREE_TAG(top) ((top) >> 32)
+
+/**
+ * @brief Taille d'un objet, arrondie pour l'alignement (chaînage compris)
+ */
+static size_t alignedObjectSize(size_t object_size)
+{
+    size_t size = (object_size < sizeof(unsigned int)) ? sizeof(unsigned int) : object_size;
+    return (size + __alignof__(max_align_t) - 1) & ~(__alignof__(max_align_t) - 1);
+}
+
+/**
+ * @brief Position du premier objet après l'en-tête
+ */
+static ShmOffset firstObject(ShmOffset slab_offset)
+{
+    ShmOffset offset = slab_offset + sizeof(ShmSlab);
+    return (offset + __alignof__(max_align_t) - 1) & ~(__alignof__(max_align_t) - 1);
+}
+
+/**
+ * @brief Renvoie l'objet d'index donné
+ */
+static unsigned int *getObject(void *base, ShmSlab *slab, unsigned int index)
+{
+    return (unsigned int *)((char *)base + slab->objects + (size_t)index * slab->object_size);
+}
+
+/**
+ * @brief Prend le sommet de la pile commune
+ *
+ * @return unsigned int : l'index + 1 de l'objet, 0 si la pile est vide
+ */
+static unsigned int popShared(void *base, ShmSlab *slab)
+{
+    unsigned long top = __atomic_load_n(&slab->free_top, __ATOMIC_ACQUIRE);
+    unsigned long new_top;
+
+    do
+    {
+        if (FREE_INDEX(top) == 0)
+        {
+            return 0;
+        }
+        unsigned int next = __atomic_load_n(getObject(base, slab, FREE_INDEX(top) - 1), __ATOMIC_RELAXED);
+        new_top = ((FREE_TAG(top) + 1) << 32) | next;
+    } while (!__atomic_compare_exchange_n(&slab->free_top, &top, new_top, false,
+        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+    __atomic_add_fetch(&slab->nb_used, 1, __ATOMIC_RELAXED);
+    return FREE_INDEX(top);
+}
+
+/**
+ * @brief Remet un objet au sommet de la pile commune
+ *
+ * @param index l'index + 1 de l'objet
+ */
+static void pushShared(void *base, ShmSlab *slab, unsigned int index)
+{
+    unsigned int *object = getObject(base, slab, index - 1);
+    unsigned long top = __atomic_load_n(&slab->free_top, __ATOMIC_RELAXED);
+    unsigned long new_top;
+
+    do
+    {
+        __atomic_store_n(object, FREE_INDEX(top), __ATOMIC_RELAXED);
+        new_top = ((FREE_TAG(top) + 1) << 32) | index;
+    } while (!__atomic_compare_exchange_n(&slab->free_top, &top, new_top, false,
+        __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+    __atomic_sub_fetch(&slab->nb_used, 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Place nécessaire dans le segment pour une réserve (en-tête compris)
+ *
+ * @param object_size la taille d'un objet
+ * @param nb_objects le nb d'objets
+ */
+size_t getShmSlabSize(size_t object_size, unsigned int nb_objects)
+{
+    return firstObject(0) + alignedObjectSize(object_size) * nb_objects;
+}
+
+/**
+ * @brief Crée une réserve dont tous les objets sont libres (créateur du segment)
+ *
+ * @param base l'adresse d'attachement du segment
+ * @param slab_offset la position de la réserve dans le segment (alignée)
+ * @param object_size la taille d'un objet
+ * @param nb_objects le nb d'objets
+ */
+void initShmSlab(void *base, ShmOffset slab_offset, size_t object_size, unsigned int nb_objects)
+{
+    ShmSlab *slab = (ShmSlab *)shmPointer(base, slab_offset);
+
+    slab->object_size = alignedObjectSize(object_size);
+    slab->nb_objects = nb_objects;
+    slab->objects = firstObject(slab_offset);
+    for (unsigned int i = 0; i < nb_objects; i++)
+    {
+        *getObject(base, slab, i) = (i + 1 < nb_objects) ? i + 2 : 0;
+    }
+    slab->nb_used = 0;
+    __atomic_store_n(&slab->free_top, (nb_objects > 0) ? 1UL : 0UL, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Alloue un objet
+ *
+ * @param base l'adresse d'attachement du segment
+ * @param slab la réserve
+ * @param cache le cache du process (NULL : pile commune directement)
+ * @return ShmOffset la position de l'objet (non initialisé), SHM_NULL si tout est alloué
+ */
+ShmOffset shmSlabAlloc(void *base, ShmSlab *slab, ShmSlabCache *cache)
+{
+    unsigned int index;
+
+    if (cache == NULL)
+    {
+        index = popShared(base, slab);
+    }
+    else
+    {
+        // cache vide : remplissage de moitié depuis la pile commune
+        while (cache->count < SHM_SLAB_CACHE_SIZE / 2 && (index = popShared(base, slab)) != 0)
+        {
+            cache->indexes[cache->count++] = index;
+        }
+        index = (cache->count > 0) ? cache->indexes[--cache->count] : 0;
+    }
+    if (index == 0)
+    {
+        return SHM_NULL;
+    }
+    return slab->objects + (size_t)(index - 1) * slab->object_size;
+}
+
+/**
+ * @brief Libère un objet alloué par shmSlabAlloc() (par n'importe quel process)
+ *
+ * @param base l'adresse d'attachement du segment
+ * @param slab la réserve de l'objet
+ * @param cache le cache du process (NULL : pile commune directement)
+ * @param object la position de l'objet, qui ne doit plus être utilisé
+ */
+void shmSlabFree(void *base, ShmSlab *slab, ShmSlabCache *cache, ShmOffset object)
+{
+    unsigned int index = (unsigned int)((object - slab->objects) / slab->object_size) + 1;
+
+    if (cache == NULL)
+    {
+        pushShared(base, slab, index);
+        return;
+    }
+    if (cache->count == SHM_SLAB_CACHE_SIZE)
+    {
+        // cache plein : la moitié retourne à la pile commune
+        while (cache->count > SHM_SLAB_CACHE_SIZE / 2)
+        {
+            pushShared(base, slab, cache->indexes[--cache->count]);
+        }
+    }
+    cache->indexes[cache->count++] = index;
+}
@@ -0,0 +1,68 @@
+/*******************************************************************************
+ * @file shm_slab.h
+ * @brief Allocateur d'objets de taille fixe dans le segment partagé (question 2).
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * Chaque process attache le segment à une adresse différente : les objets
+ * alloués dans le segment sont donc désignés par leur position depuis le début
+ * du segment (ShmOffset) et non par un pointeur. shmPointer() convertit une
+ * position en pointeur pour le process courant.
+ *
+ * Une réserve (ShmSlab) est un en-tête suivi de nb_objects objets de même taille,
+ * le tout placé dans le segment :
+ * -> les objets libres forment une pile commune sans verrou, partagée par tous
+ *    les process (compteur de modifications contre le problème ABA)
+ * -> un process qui alloue souvent (le père du serveur de réservation) garde un
+ *    cache local d'au plus SHM_SLAB_CACHE_SIZE objets, rempli de moitié à la fois ;
+ *    un process éphémère (fils) alloue et libère directement dans la pile commune.
+ * La mémoire est bornée par nb_objects, fixé à la création du segment.
+ *
+ * @note les objets du cache d'un process terminé sont perdus : seul un process
+ * qui vit aussi longtemps que le segment doit avoir un cache.
+ ******************************************************************************/
+
+#ifndef SHM_SLAB_H
+#define SHM_SLAB_H
+
+#include "common.h"
+
+#define SHM_SLAB_CACHE_SIZE 16 // nb max d'objets libres dans le cache d'un process
+#define SHM_NULL 0 // position nulle (l'en-tête du segment n'est jamais alloué)
+
+typedef size_t ShmOffset; // position dans le segment
+
+// Réserve d'objets, dans le segment
+typedef struct {
+    size_t object_size;
+    unsigned int nb_objects;
+    ShmOffset objects; // position du premier objet
+    unsigned long free_top; // (nb de modifications << 32) | (index + 1) du sommet, 0 : pile vide
+    unsigned int nb_used; // nb d'objets hors pile commune
+} ShmSlab;
+
+// Cache d'objets libres d'un process (hors segment)
+typedef struct {
+    unsigned int indexes[SHM_SLAB_CACHE_SIZE];
+    int count;
+} ShmSlabCache;
+
+/**
+ * @brief Pointeur, dans le process courant, vers une position du segment
+ *
+ * @param base l'adresse d'attachement du segment
+ * @param offset la position (SHM_NULL : NULL)
+ */
+static inline void *shmPointer(void *base, ShmOffset offset)
+{
+    return (offset == SHM_NULL) ? NULL : (char *)base + offset;
+}
+
+//prototypes de fonctions
+size_t getShmSlabSize(size_t object_size, unsigned int nb_objects);
+void initShmSlab(void *base, ShmOffset slab_offset, size_t object_size, unsigned int nb_objects);
+ShmOffset shmSlabAlloc(void *base, ShmSlab *slab, ShmSlabCache *cache);
+void shmSlabFree(void *base, ShmSlab *slab, ShmSlabCache *cache, ShmOffset object);
+
+#endif
@@ -0,0 +1,94 @@
+/*******************************************************************************
+ * @file show_index.c
+ * @brief Implémentation de l'index des spectacles de la question 2.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * cf show_index.h
+ ******************************************************************************/
+
+#include "show_index.h"
+#include "show_lookup.h"
+#include "shm_heap.h"
+#include "server.h"
+
+/**
+ * @brief Indique si l'index de nb_shows spectacles tient dans un bloc du tas
+ */
+bool canIndexShows(int nb_shows)
+{
+    return getShowIndexSize(nb_shows) <= SHM_HEAP_MAX_ALLOC;
+}
+
+/**
+ * @brief Construit l'index des spectacles de shows[] dans le tas partagé
+ * (créateur du segment, après le remplissage du tableau)
+ *
+ * En cas d'échec, les outils IPC sont supprimés : l'autre process du serveur
+ * s'arrête sur l'échec de son attente dans la file.
+ *
+ * @param nb_shows le nb de spectacles de shows[]
+ */
+void buildShowIndex(int nb_shows)
+{
+    ShmHeapPtr block;
+
+    if ((block = shmHeapAlloc(getShowIndexSize(nb_shows))) == SHM_HEAP_NULL)
+    {
+        // le serveur ne peut pas fonctionner : rien ne doit rester derrière lui
+        fprintf(stderr, "%s : Tas partage plein, index des spectacles impossible.\n", process_name);
+        removeIpcResources();
+        exit(EXIT_FAILURE);
+    }
+    fillShowIndex((ShowIndex *)shmHeapPointer(block), shows, nb_shows);
+    // publication de l'index pour les autres process
+    __atomic_store_n(&shm_heap->roots[SHM_ROOT_SHOW_INDEX], block, __ATOMIC_RELEASE);
+    printf("%s : Index des spectacles construit (comparaisons %s).\n",
+        process_name, selectLookupKernel(NULL));
+}
+
+/**
+ * @brief Recherche les spectacles d'un lot de messages
+ *
+ * @param msgs les messages (identifiants recherchés)
+ * @param nb_msgs le nb de messages
+ * @param indexes reçoit l'index de chaque spectacle dans shows[], -1 s'il n'existe pas
+ */
+void findShows(const Message *msgs, int nb_msgs, int *indexes)
+{
+    const ShowIndex *index = (const ShowIndex *)shmHeapPointer(
+        __atomic_load_n(&shm_heap->roots[SHM_ROOT_SHOW_INDEX], __ATOMIC_ACQUIRE));
+    ShowKey keys[SHOW_LOOKUP_BATCH];
+
+    for (int done = 0; done < nb_msgs; done += SHOW_LOOKUP_BATCH)
+    {
+        int nb = (nb_msgs - done < SHOW_LOOKUP_BATCH) ? nb_msgs - done : SHOW_LOOKUP_BATCH;
+        for (int k = 0; k < nb; k++)
+        {
+            keys[k] = makeShowKey(msgs[done + k].show_id);
+        }
+        if (index == NULL)
+        {
+            memset(&indexes[done], 0xFF, nb * sizeof(int)); // -1 : pas d'index
+            continue;
+        }
+        lookupShows(index, keys, nb, &indexes[done]);
+    }
+}
+
+/**
+ * @brief Recherche un spectacle
+ *
+ * @param show_id l'identifiant recherché (SHOW_ID_LEN octets, champ d'un message)
+ * @return int : l'index du spectacle dans shows[], -1 s'il n'existe pas
+ */
+int findShow(const char *show_id)
+{
+    Message msg;
+    int index;
+
+    memcpy(msg.show_id, show_id, SHOW_ID_LEN);
+    findShows(&msg, 1, &index);
+    return index;
+}
@@ -0,0 +1,27 @@
+/*******************************************************************************
+ * @file show_index.h
+ * @brief Index des spectacles du serveur de la question 2.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * Table de hachage de l'identifiant d'un spectacle vers son index dans shows[]
+ * (cf show_lookup.h), placée dans le tas partagé (cf shm_heap.h, racine
+ * SHM_ROOT_SHOW_INDEX) : construite une fois par le créateur du segment,
+ * elle sert à tous les process du serveur.
+ * Recherche en O(1), par lots de comparaisons vectorisées, au lieu du parcours
+ * de shows[] par strcmp().
+ ******************************************************************************/
+
+#ifndef SHOW_INDEX_H
+#define SHOW_INDEX_H
+
+#include "common.h"
+
+//prototypes de fonctions
+bool canIndexShows(int nb_shows);
+void buildShowIndex(int nb_shows);
+int findShow(const char *show_id);
+void findShows(const Message *msgs, int nb_msgs, int *indexes);
+
+#endif
@@ -0,0 +1,234 @@
+/*******************************************************************************
+ * @file show_lookup.c
+ * @brief Implémentation de la recherche vectorisée des spectacles (question 2).
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * cf show_lookup.h
+ * Un noyau compare un seau à une clé et renvoie deux masques de SHOW_BUCKET_SIZE bits :
+ * clés égales (bits 0 à 3) et emplacements vides (bits 4 à 7).
+ * Les noyaux vectoriels sont compilés pour leur jeu d'instructions
+ * (attribut target) : le reste du serveur ne dépend pas des options de compilation.
+ ******************************************************************************/
+
+#include "show_lookup.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HAVE_X86_KERNELS
+#endif
+
+typedef unsigned int (*MatchKernel)(const ShowBucket *bucket, ShowKey key);
+
+/**
+ * @brief Noyau de référence : une clé à la fois
+ */
+static unsigned int matchBucketScalar(const ShowBucket *bucket, ShowKey key)
+{
+    unsigned int mask = 0;
+
+    for (int i = 0; i < SHOW_BUCKET_SIZE; i++)
+    {
+        mask |= (unsigned int)(bucket->keys[i] == key) << i;
+        mask |= (unsigned int)(bucket->keys[i] == 0) << (i + SHOW_BUCKET_SIZE);
+    }
+    return mask;
+}
+
+#ifdef HAVE_X86_KERNELS
+/**
+ * @brief Noyau SSE4.2 : deux comparaisons de 2 clés
+ */
+__attribute__((target("sse4.2")))
+static unsigned int matchBucketSse42(const ShowBucket *bucket, ShowKey key)
+{
+    __m128i wanted = _mm_set1_epi64x((long long)key);
+    __m128i zero = _mm_setzero_si128();
+    __m128i low = _mm_loadu_si128((const __m128i *)&bucket->keys[0]);
+    __m128i high = _mm_loadu_si128((const __m128i *)&bucket->keys[2]);
+    unsigned int match = _mm_movemask_pd(_mm_castsi128_pd(_mm_cmpeq_epi64(low, wanted)))
+        | _mm_movemask_pd(_mm_castsi128_pd(_mm_cmpeq_epi64(high, wanted))) << 2;
+    unsigned int empty = _mm_movemask_pd(_mm_castsi128_pd(_mm_cmpeq_epi64(low, zero)))
+        | _mm_movemask_pd(_mm_castsi128_pd(_mm_cmpeq_epi64(high, zero))) << 2;
+    return match | empty << SHOW_BUCKET_SIZE;
+}
+
+/**
+ * @brief Noyau AVX2 : le seau en une comparaison
+ */
+__attribute__((target("avx2")))
+static unsigned int matchBucketAvx2(const ShowBucket *bucket, ShowKey key)
+{
+    __m256i keys = _mm256_loadu_si256((const __m256i *)bucket->keys);
+    unsigned int match = _mm256_movemask_pd(_mm256_castsi256_pd(
+        _mm256_cmpeq_epi64(keys, _mm256_set1_epi64x((long long)key))));
+    unsigned int empty = _mm256_movemask_pd(_mm256_castsi256_pd(
+        _mm256_cmpeq_epi64(keys, _mm256_setzero_si256())));
+    return match | empty << SHOW_BUCKET_SIZE;
+}
+#endif
+
+// variables du module (propres au process)
+static MatchKernel match_bucket = NULL; // noyau choisi (NULL : pas encore)
+static const char *kernel_name = "scalaire";
+
+/**
+ * @brief Choisit le noyau de comparaison
+ *
+ * @param name "avx2", "sse4.2", "scalaire", ou NULL pour le meilleur disponible
+ * @return const char* le nom du noyau retenu (scalaire si celui demandé n'est pas disponible)
+ */
+const char *selectLookupKernel(const char *name)
+{
+    match_bucket = matchBucketScalar;
+    kernel_name = "scalaire";
+#ifdef HAVE_X86_KERNELS
+    __builtin_cpu_init();
+    if ((name == NULL || strcmp(name, "avx2") == 0) && __builtin_cpu_supports("avx2"))
+    {
+        match_bucket = matchBucketAvx2;
+        kernel_name = "avx2";
+    }
+    else if ((name == NULL || strcmp(name, "sse4.2") == 0) && __builtin_cpu_supports("sse4.2"))
+    {
+        match_bucket = matchBucketSse42;
+        kernel_name = "sse4.2";
+    }
+#endif
+    return kernel_name;
+}
+
+/**
+ * @brief Clé d'un identifiant de spectacle (caractères après '\0' ignorés)
+ */
+ShowKey makeShowKey(const char *show_id)
+{
+    ShowKey key = 0;
+
+    for (int i = 0; i < SHOW_ID_LEN - 1 && show_id[i] != '\0'; i++)
+    {
+        key |= (ShowKey)(unsigned char)show_id[i] << (8 * i);
+    }
+    return key;
+}
+
+/**
+ * @brief Seau de départ d'une clé
+ *
+ * Les identifiants ne diffèrent souvent que par leurs derniers caractères
+ * (octets de poids fort) : ils sont mélangés à tous les bits avant le masque.
+ */
+static unsigned int hashShowKey(ShowKey key, unsigned int nb_buckets)
+{
+    key ^= key >> 33;
+    key *= 0xFF51AFD7ED558CCDUL;
+    key ^= key >> 33;
+    return (unsigned int)key & (nb_buckets - 1);
+}
+
+/**
+ * @brief Nb de seaux pour un catalogue (remplissage moyen de moitié au plus)
+ */
+static unsigned int getNbBuckets(int nb_shows)
+{
+    unsigned int nb_buckets = 2;
+
+    while (nb_buckets * SHOW_BUCKET_SIZE < 2U * nb_shows)
+    {
+        nb_buckets *= 2;
+    }
+    return nb_buckets;
+}
+
+/**
+ * @brief Taille d'une table pour un catalogue
+ *
+ * @param nb_shows le nb de spectacles
+ */
+size_t getShowIndexSize(int nb_shows)
+{
+    return sizeof(ShowIndex) + getNbBuckets(nb_shows) * sizeof(ShowBucket);
+}
+
+/**
+ * @brief Remplit une table (mémoire de getShowIndexSize() octets) avec un tableau de spectacles
+ *
+ * @param index la table
+ * @param shows le tableau
+ * @param nb_shows le nb de spectacles du tableau
+ */
+void fillShowIndex(ShowIndex *index, const Message *shows, int nb_shows)
+{
+    index->nb_buckets = getNbBuckets(nb_shows);
+    index->nb_shows = nb_shows;
+    memset(index->buckets, 0, index->nb_buckets * sizeof(ShowBucket));
+    for (int i = 0; i < nb_shows; i++)
+    {
+        ShowKey key = makeShowKey(shows[i].show_id);
+        unsigned int bucket = hashShowKey(key, index->nb_buckets);
+        int slot;
+
+        while (1)
+        {
+            for (slot = 0; slot < SHOW_BUCKET_SIZE && index->buckets[bucket].keys[slot] != 0; slot++);
+            if (slot < SHOW_BUCKET_SIZE)
+            {
+                break;
+            }
+            bucket = (bucket + 1) & (index->nb_buckets - 1);
+        }
+        index->buckets[bucket].keys[slot] = key;
+        index->buckets[bucket].indexes[slot] = i;
+    }
+}
+
+/**
+ * @brief Résout un lot de clés
+ *
+ * @param index la table
+ * @param keys les clés (makeShowKey())
+ * @param nb_keys le nb de clés (au plus SHOW_LOOKUP_BATCH)
+ * @param indexes reçoit l'index de chaque spectacle, -1 s'il n'existe pas
+ */
+void lookupShows(const ShowIndex *index, const ShowKey *keys, int nb_keys, int *indexes)
+{
+    unsigned int buckets[SHOW_LOOKUP_BATCH];
+
+    if (match_bucket == NULL)
+    {
+        selectLookupKernel(NULL);
+    }
+    // préchargement des seaux du lot
+    for (int k = 0; k < nb_keys; k++)
+    {
+        buckets[k] = hashShowKey(keys[k], index->nb_buckets);
+        __builtin_prefetch(&index->buckets[buckets[k]]);
+    }
+    for (int k = 0; k < nb_keys; k++)
+    {
+        unsigned int bucket = buckets[k];
+
+        indexes[k] = -1;
+        if (keys[k] == 0)
+        {
+            continue;
+        }
+        while (1)
+        {
+            unsigned int mask = match_bucket(&index->buckets[bucket], keys[k]);
+            unsigned int match = mask & ((1U << SHOW_BUCKET_SIZE) - 1);
+            if (match != 0)
+            {
+                indexes[k] = index->buckets[bucket].indexes[__builtin_ctz(match)];
+                break;
+            }
+            if ((mask >> SHOW_BUCKET_SIZE) != 0)
+            {
+                // seau non plein : la clé n'a pas débordé plus loin
+                break;
+            }
+            bucket = (bucket + 1) & (index->nb_buckets - 1);
+        }
+    }
+}
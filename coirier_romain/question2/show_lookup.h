@@ -0,0 +1,55 @@
+/*******************************************************************************
+ * @file show_lookup.h
+ * @brief Recherche vectorisée des identifiants de spectacles (question 2).
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * Un identifiant de spectacle (6 caractères et '\0') tient dans un mot de
+ * 8 octets (ShowKey, octets inutilisés à 0) : une comparaison d'identifiants
+ * est une comparaison d'entiers, et plusieurs comparaisons tiennent dans
+ * une instruction vectorielle.
+ *
+ * La table (ShowIndex) est une table de hachage par seaux de SHOW_BUCKET_SIZE clés :
+ * un seau est comparé à la clé cherchée en une fois (AVX2 : 4 clés, SSE4.2 : 2 x 2 clés,
+ * sinon boucle), le noyau étant choisi à l'exécution selon le processeur
+ * (selectLookupKernel()). Les seaux pleins débordent sur le suivant.
+ *
+ * lookupShows() résout un lot d'identifiants : les seaux de tout le lot sont
+ * d'abord préchargés, puis comparés, pour recouvrir les défauts de cache
+ * d'un grand catalogue. bench_lookup.c compare les noyaux et les tailles de lot.
+ *
+ * @note module sans état partagé : la table peut être dans le tas partagé
+ * (cf show_index.h) ou ailleurs.
+ ******************************************************************************/
+
+#ifndef SHOW_LOOKUP_H
+#define SHOW_LOOKUP_H
+
+#include "common.h"
+
+#define SHOW_BUCKET_SIZE 4 // nb de clés par seau
+#define SHOW_LOOKUP_BATCH 64 // taille max d'un lot pour lookupShows()
+
+typedef unsigned long ShowKey; // identifiant sur 8 octets, 0 : emplacement vide
+
+// Seau de la table : clés comparées ensemble, puis index des spectacles
+typedef struct {
+    ShowKey keys[SHOW_BUCKET_SIZE];
+    int indexes[SHOW_BUCKET_SIZE];
+} ShowBucket;
+
+typedef struct {
+    unsigned int nb_buckets; // puissance de 2
+    unsigned int nb_shows;
+    ShowBucket buckets[];
+} ShowIndex;
+
+//prototypes de fonctions
+ShowKey makeShowKey(const char *show_id);
+size_t getShowIndexSize(int nb_shows);
+void fillShowIndex(ShowIndex *index, const Message *shows, int nb_shows);
+void lookupShows(const ShowIndex *index, const ShowKey *keys, int nb_keys, int *indexes);
+const char *selectLookupKernel(const char *name);
+
+#endif
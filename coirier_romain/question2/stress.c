@@ -0,0 +1,355 @@
+/*******************************************************************************
+ * @file stress.c
+ * @brief Test de charge du serveur de la question 2 avec contrôle des invariants.
+ * @author Romain COIRIER
+ * @date 18/10/2026
+ * @version 1.0
+ *
+ * nb_clients process clients envoient en même temps nb_operations requêtes
+ * chacun au serveur en cours d'exécution : réservations de 1 à MAX_STRESS_SEATS
+ * places et consultations, sur les spectacles de SHOW_IDS et les nb_spectacles
+ * premiers spectacles générés (serveur lancé avec -c au moins nb_spectacles).
+ * Chaque client tire ses requêtes d'un générateur initialisé par la graine et
+ * son numéro : une même commande rejoue les mêmes suites de requêtes (seul
+ * l'entrelacement entre clients varie d'une exécution à l'autre).
+ *
+ * Invariants vérifiés :
+ * -> chaque réponse : réservation acceptée pour exactement le nb de places
+ *    demandé, refusée avec un nb de places restantes entre 0 et le nb
+ *    demandé - 1 ; places restantes jamais négatives ni supérieures à la
+ *    capacité, et jamais en hausse d'une réponse à l'autre pour un même client
+ *    (les places ne sont jamais rendues en question 2)
+ * -> en fin de test : pour chaque spectacle,
+ *    places vendues + places restantes == capacité relevée au départ.
+ * La capacité de chaque spectacle est relevée par une consultation avant le
+ * lancement des clients : le serveur ne doit pas avoir d'autres clients.
+ *
+ * Compilation :
+ * $ gcc -O2 -o stress stress.c
+ * Utilisation : ./stress [nb_clients] [nb_operations] [graine] [nb_spectacles]
+ * (les requêtes refusées par un serveur saturé, cf option -m, sont comptées
+ * à part et ne sont pas une erreur)
+ *
+ * @return EXIT_SUCCESS si aucun invariant n'a été violé
+ ******************************************************************************/
+
+#include "common.h"
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+#define DEFAULT_NB_CLIENTS 16
+#define DEFAULT_NB_OPERATIONS 10000 // par client (un fork du serveur par réservation)
+#define DEFAULT_SEED 103
+#define MAX_STRESS_SEATS 4 // places par réservation (1 à MAX_STRESS_SEATS)
+#define CONSULT_PERCENT 30 // part des consultations
+#define MAX_REPORTED 10 // violations détaillées par client
+
+// Compteurs d'un client (projection partagée avec le père)
+// suivis d'un tableau de nb_shows compteurs : places vendues
+typedef struct {
+    long nb_booked; // réservations acceptées
+    long nb_refused; // réservations refusées faute de places
+    long nb_consulted; // consultations
+    long nb_busy; // requêtes refusées (saturation)
+    long nb_violations; // invariants violés
+} StressCounters;
+
+static int queue_id;
+static int nb_shows;
+static int nb_named; // spectacles de SHOW_IDS
+static int *capacities; // capacité relevée de chaque spectacle
+
+/**
+ * @brief Identifiant du j-ième spectacle du catalogue (comme getCatalogShowId() du serveur)
+ */
+static void makeShowId(int j, char show_id[SHOW_ID_LEN])
+{
+    static const char digits[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+    if (j < nb_named)
+    {
+        memcpy(show_id, SHOW_IDS[j], SHOW_ID_LEN);
+        return;
+    }
+    j -= nb_named;
+    show_id[0] = 'C';
+    for (int k = SHOW_ID_LEN - 2; k > 0; k--)
+    {
+        show_id[k] = digits[j % 36];
+        j /= 36;
+    }
+    show_id[SHOW_ID_LEN - 1] = '\0';
+}
+
+/**
+ * @brief Tirage pseudo-aléatoire reproductible (xorshift64)
+ */
+static unsigned long nextRandom(unsigned long *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+/**
+ * @brief Envoie une requête et attend sa réponse
+ *
+ * @return bool : false si le serveur ne répond plus (file supprimée)
+ */
+static bool sendRequest(RequestType request_type, int show, int nb_seats,
+    Request *msg_req, Response *msg_resp)
+{
+    memset(msg_req, 0, sizeof(Request));
+    msg_req->msg_type = request_type;
+    msg_req->pid = getpid();
+    makeShowId(show, msg_req->msg.show_id);
+    msg_req->msg.nb_seats = nb_seats;
+
+    return msgsnd(queue_id, msg_req, sizeof(Request) - sizeof(long), 0) != -1
+        && msgrcv(queue_id, msg_resp, sizeof(Response) - sizeof(long), msg_req->pid, 0) != -1;
+}
+
+/**
+ * @brief Signale un invariant violé (détail des MAX_REPORTED premiers)
+ */
+static void reportViolation(StressCounters *counters, int client, long operation,
+    const char *invariant, const Response *msg_resp)
+{
+    if (counters->nb_violations++ < MAX_REPORTED)
+    {
+        fprintf(stderr, "Client %d, operation %ld : %s (reponse %s %d places).\n",
+            client, operation, invariant, msg_resp->msg.show_id, msg_resp->msg.nb_seats);
+    }
+}
+
+/**
+ * @brief Vérifie une réponse à une requête acceptée par le serveur
+ *
+ * @param sold les places vendues par spectacle
+ * @param last_seen les dernières places restantes vues par le client, par spectacle
+ */
+static void checkResponse(const Request *msg_req, const Response *msg_resp, int show,
+    StressCounters *counters, long *sold, int *last_seen, int client, long operation)
+{
+    int nb_seats = msg_resp->msg.nb_seats;
+    int remaining;
+
+    if (strncmp(msg_resp->msg.show_id, msg_req->msg.show_id, SHOW_ID_LEN) != 0)
+    {
+        reportViolation(counters, client, operation, "reponse pour un autre spectacle", msg_resp);
+        return;
+    }
+    if (msg_req->msg_type == REQUEST_CONSULT)
+    {
+        counters->nb_consulted++;
+        remaining = nb_seats;
+    }
+    else if (nb_seats > 0)
+    {
+        counters->nb_booked++;
+        if (nb_seats != msg_req->msg.nb_seats)
+        {
+            reportViolation(counters, client, operation, "reservation acceptee pour un autre nb de places", msg_resp);
+            return;
+        }
+        sold[show] += nb_seats;
+        // au plus les places vues avant, moins celles-ci
+        remaining = last_seen[show] - nb_seats;
+    }
+    else
+    {
+        counters->nb_refused++;
+        remaining = -nb_seats;
+        if (remaining >= msg_req->msg.nb_seats)
+        {
+            reportViolation(counters, client, operation, "refus avec des places restantes suffisantes", msg_resp);
+        }
+    }
+    if (remaining < 0 || remaining > capacities[show])
+    {
+        reportViolation(counters, client, operation, "places restantes hors de [0, capacite]", msg_resp);
+    }
+    else if (remaining > last_seen[show])
+    {
+        reportViolation(counters, client, operation, "places restantes en hausse", msg_resp);
+    }
+    else
+    {
+        last_seen[show] = remaining;
+    }
+}
+
+/**
+ * @brief Boucle d'un process client
+ */
+static void runClient(int client, unsigned long seed, long nb_operations,
+    StressCounters *counters, long *sold)
+{
+    unsigned long random_state = seed * 2654435761UL + client + 1;
+    int *last_seen = (int *)malloc(nb_shows * sizeof(int));
+    Request msg_req;
+    Response msg_resp;
+
+    if (last_seen == NULL)
+    {
+        perror("Echec malloc.\n");
+        exit(EXIT_FAILURE);
+    }
+    memcpy(last_seen, capacities, nb_shows * sizeof(int));
+    for (long n = 0; n < nb_operations; n++)
+    {
+        bool consult = nextRandom(&random_state) % 100 < CONSULT_PERCENT;
+        int show = nextRandom(&random_state) % nb_shows;
+        int nb_seats = 1 + nextRandom(&random_state) % MAX_STRESS_SEATS;
+
+        if (!sendRequest(consult ? REQUEST_CONSULT : REQUEST_RESA, show, consult ? 0 : nb_seats,
+            &msg_req, &msg_resp))
+        {
+            perror("Serveur injoignable.\n");
+            counters->nb_violations++;
+            break;
+        }
+        if (msg_resp.status == STATUS_BUSY)
+        {
+            counters->nb_busy++;
+            continue;
+        }
+        checkResponse(&msg_req, &msg_resp, show, counters, sold, last_seen, client, n);
+    }
+    free(last_seen);
+}
+
+/**
+ * @brief Relève les places restantes de chaque spectacle
+ *
+ * @return bool : false si le serveur ne répond pas ou ne connaît pas un spectacle
+ */
+static bool readSeats(int *seats)
+{
+    Request msg_req;
+    Response msg_resp;
+
+    for (int show = 0; show < nb_shows; show++)
+    {
+        if (!sendRequest(REQUEST_CONSULT, show, 0, &msg_req, &msg_resp)
+            || msg_resp.msg.show_id[0] == '\0')
+        {
+            return false;
+        }
+        seats[show] = msg_resp.msg.nb_seats;
+    }
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    int nb_clients = (argc > 1) ? atoi(argv[1]) : DEFAULT_NB_CLIENTS;
+    long nb_operations = (argc > 2) ? atol(argv[2]) : DEFAULT_NB_OPERATIONS;
+    unsigned long seed = (argc > 3) ? strtoul(argv[3], NULL, 10) : DEFAULT_SEED;
+    int catalog_size = (argc > 4) ? atoi(argv[4]) : 0;
+
+    if (nb_clients < 1 || nb_operations < 1 || catalog_size < 0 || catalog_size > MAX_CATALOG_SIZE)
+    {
+        fprintf(stderr, "Utilisation : %s [nb_clients] [nb_operations] [graine] [nb_spectacles]\n", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+    if ((queue_id = msgget(ftok(KEY_FILENAME, KEY_ID), 0666)) == -1)
+    {
+        perror("Serveur introuvable (file de messages).\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // capacités relevées au départ
+    for (nb_named = 0; SHOW_IDS[nb_named] != NULL; nb_named++);
+    nb_shows = nb_named + catalog_size;
+    capacities = (int *)malloc(2 * nb_shows * sizeof(int));
+    if (capacities == NULL)
+    {
+        perror("Echec malloc.\n");
+        exit(EXIT_FAILURE);
+    }
+    int *remaining = capacities + nb_shows;
+    if (!readSeats(capacities))
+    {
+        fprintf(stderr, "Serveur injoignable ou catalogue incomplet (option -c du serveur).\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // compteurs des clients, partagés avec le père
+    size_t client_size = sizeof(StressCounters) + nb_shows * sizeof(long);
+    size_t size = nb_clients * client_size;
+    char *reports = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (reports == MAP_FAILED)
+    {
+        perror("Echec mmap.\n");
+        exit(EXIT_FAILURE);
+    }
+    printf("Graine %lu : %d clients, %ld operations chacun, %d spectacles.\n",
+        seed, nb_clients, nb_operations, nb_shows);
+    fflush(stdout);
+    for (int c = 0; c < nb_clients; c++)
+    {
+        pid_t pid = fork();
+        if (pid == -1)
+        {
+            perror("Echec fork.\n");
+            exit(EXIT_FAILURE);
+        }
+        if (pid == 0)
+        {
+            StressCounters *counters = (StressCounters *)(reports + c * client_size);
+            runClient(c, seed, nb_operations, counters, (long *)(counters + 1));
+            exit(EXIT_SUCCESS);
+        }
+    }
+    while (wait(NULL) > 0);
+
+    // bilan
+    StressCounters total;
+    memset(&total, 0, sizeof(total));
+    if (!readSeats(remaining))
+    {
+        perror("Serveur injoignable.\n");
+        exit(EXIT_FAILURE);
+    }
+    long total_capacity = 0, total_sold = 0, total_remaining = 0;
+    for (int show = 0; show < nb_shows; show++)
+    {
+        long sold = 0;
+        for (int c = 0; c < nb_clients; c++)
+        {
+            sold += ((long *)((StressCounters *)(reports + c * client_size) + 1))[show];
+        }
+        if (sold + remaining[show] != capacities[show] || remaining[show] < 0)
+        {
+            char show_id[SHOW_ID_LEN];
+            makeShowId(show, show_id);
+            printf("%s : capacite %d, vendues %ld, restantes %d -> INVARIANT VIOLE\n",
+                show_id, capacities[show], sold, remaining[show]);
+            total.nb_violations++;
+        }
+        total_capacity += capacities[show];
+        total_sold += sold;
+        total_remaining += remaining[show];
+    }
+    printf("Catalogue : capacite %ld, vendues %ld, restantes %ld.\n",
+        total_capacity, total_sold, total_remaining);
+    for (int c = 0; c < nb_clients; c++)
+    {
+        StressCounters *counters = (StressCounters *)(reports + c * client_size);
+        total.nb_booked += counters->nb_booked;
+        total.nb_refused += counters->nb_refused;
+        total.nb_consulted += counters->nb_consulted;
+        total.nb_busy += counters->nb_busy;
+        total.nb_violations += counters->nb_violations;
+    }
+    printf("Reservations %ld (refusees %ld), consultations %ld, saturation %ld.\n",
+        total.nb_booked, total.nb_refused, total.nb_consulted, total.nb_busy);
+    printf("%s : %ld invariant(s) viole(s).\n", total.nb_violations == 0 ? "Succes" : "Echec",
+        total.nb_violations);
+    munmap(reports, size);
+    free(capacities);
+    return total.nb_violations == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}